@@ -0,0 +1,115 @@
+#include "benchmark/benchmark.h"
+#include <cassert>
+#include <cstring>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "hb.h"
+
+static const char *default_texts[] =
+{
+  "perf/texts/en-thelittleprince.txt",
+  "perf/texts/fa-thelittleprince.txt",
+  "perf/texts/hi-words.txt",
+};
+
+static const char **texts = default_texts;
+static unsigned num_texts = sizeof (default_texts) / sizeof (default_texts[0]);
+
+enum encoding_t
+{
+  utf8,
+  utf16,
+  utf32,
+};
+
+/* benchmark for adding a whole document to a buffer */
+static void BM_BufferAdd (benchmark::State &state,
+			  encoding_t encoding,
+			  const char *text_path)
+{
+  hb_blob_t *text_blob = hb_blob_create_from_file_or_fail (text_path);
+  assert (text_blob);
+  unsigned text_length;
+  const char *text = hb_blob_get_data (text_blob, &text_length);
+
+  /* Decode once to get the codepoints, then encode them for the other
+   * encodings. */
+  hb_buffer_t *buf = hb_buffer_create ();
+  hb_buffer_add_utf8 (buf, text, text_length, 0, -1);
+  unsigned count;
+  hb_glyph_info_t *info = hb_buffer_get_glyph_infos (buf, &count);
+
+  uint16_t *text16 = (uint16_t *) calloc (2 * count, sizeof (uint16_t));
+  uint32_t *text32 = (uint32_t *) calloc (count, sizeof (uint32_t));
+  assert (text16 && text32);
+  unsigned length16 = 0;
+  for (unsigned i = 0; i < count; i++)
+  {
+    hb_codepoint_t u = text32[i] = info[i].codepoint;
+    if (u < 0x10000u)
+      text16[length16++] = u;
+    else
+    {
+      text16[length16++] = 0xD800u + ((u - 0x10000u) >> 10);
+      text16[length16++] = 0xDC00u + ((u - 0x10000u) & 0x03FFu);
+    }
+  }
+
+  for (auto _ : state)
+  {
+    hb_buffer_clear_contents (buf);
+    switch (encoding)
+    {
+      case utf8:  hb_buffer_add_utf8  (buf, text, text_length, 0, -1); break;
+      case utf16: hb_buffer_add_utf16 (buf, text16, length16, 0, -1); break;
+      case utf32: hb_buffer_add_utf32 (buf, text32, count, 0, -1); break;
+    }
+    benchmark::DoNotOptimize (hb_buffer_get_length (buf));
+  }
+  state.SetBytesProcessed (state.iterations () * text_length);
+
+  free (text32);
+  free (text16);
+  hb_buffer_destroy (buf);
+  hb_blob_destroy (text_blob);
+}
+
+static void test_encoding (encoding_t encoding,
+			   const char *encoding_name,
+			   const char *text_path)
+{
+  char name[1024] = "BM_BufferAdd/";
+  const char *p = strrchr (text_path, '/');
+  strcat (name, p ? p + 1 : text_path);
+  strcat (name, "/");
+  strcat (name, encoding_name);
+
+  benchmark::RegisterBenchmark (name, BM_BufferAdd, encoding, text_path)
+   ->Unit(benchmark::kMicrosecond);
+}
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+
+  if (argc > 1)
+  {
+    num_texts = argc - 1;
+    texts = (const char **) argv + 1;
+  }
+
+#define TEST_ENCODING(encoding) test_encoding (encoding, #encoding, texts[i])
+  for (unsigned i = 0; i < num_texts; i++)
+  {
+    TEST_ENCODING (utf8);
+    TEST_ENCODING (utf16);
+    TEST_ENCODING (utf32);
+  }
+#undef TEST_ENCODING
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+}
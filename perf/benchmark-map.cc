@@ -64,5 +64,88 @@ static void BM_MapLookup(benchmark::State& state) {
 BENCHMARK(BM_MapLookup)
     ->Range(1 << 4, 1 << 20); // Map size
 
+/* Build a map of varying size from scratch. */
+static void BM_MapBuild(benchmark::State& state) {
+  unsigned map_size = state.range(0);
+
+  for (auto _ : state) {
+    hb_map_t* map = hb_map_create ();
+    for (unsigned i = 0; i < map_size; i++)
+      hb_map_set (map, i * 2654435761u, i);
+    hb_map_destroy (map);
+  }
+}
+BENCHMARK(BM_MapBuild)
+    ->Unit(benchmark::kMicrosecond)
+    ->Range(1 << 4, 1 << 16); // Map size
+
+/* Lookup of keys present in maps of various sizes. */
+static void BM_MapLookupHit(benchmark::State& state) {
+  unsigned map_size = state.range(0);
+
+  hb_map_t* original = hb_map_create ();
+  RandomMap(map_size, original);
+  assert(hb_map_get_population(original) == map_size);
+
+  hb_codepoint_t *keys = (hb_codepoint_t *) calloc (map_size, sizeof (hb_codepoint_t));
+  int idx = -1;
+  hb_codepoint_t k, v;
+  for (unsigned i = 0; hb_map_next (original, &idx, &k, &v); i++)
+    keys[i] = k;
+
+  unsigned i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        hb_map_get (original, keys[i++ % map_size]));
+  }
+
+  free (keys);
+  hb_map_destroy(original);
+}
+BENCHMARK(BM_MapLookupHit)
+    ->Range(1 << 4, 1 << 20); // Map size
+
+/* Lookup of keys absent from maps of various sizes. */
+static void BM_MapLookupMiss(benchmark::State& state) {
+  unsigned map_size = state.range(0);
+
+  hb_map_t* original = hb_map_create ();
+  RandomMap(map_size, original);
+  assert(hb_map_get_population(original) == map_size);
+
+  /* rand() never returns values above RAND_MAX. */
+  hb_codepoint_t needle = (hb_codepoint_t) RAND_MAX + 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        hb_map_has (original, needle++));
+  }
+
+  hb_map_destroy(original);
+}
+BENCHMARK(BM_MapLookupMiss)
+    ->Range(1 << 4, 1 << 20); // Map size
+
+/* Full iteration of maps of various sizes. */
+static void BM_MapIteration(benchmark::State& state) {
+  unsigned map_size = state.range(0);
+
+  hb_map_t* original = hb_map_create ();
+  RandomMap(map_size, original);
+  assert(hb_map_get_population(original) == map_size);
+
+  for (auto _ : state) {
+    int idx = -1;
+    hb_codepoint_t k, v, sum = 0;
+    while (hb_map_next (original, &idx, &k, &v))
+      sum += v;
+    benchmark::DoNotOptimize (sum);
+  }
+
+  hb_map_destroy(original);
+}
+BENCHMARK(BM_MapIteration)
+    ->Unit(benchmark::kMicrosecond)
+    ->Range(1 << 4, 1 << 16); // Map size
+
 
 BENCHMARK_MAIN();
@@ -5,6 +5,8 @@
 
 #include "hb-ot.h"
 
+#include <cstdio>
+
 static void BM_hb_ot_tags_from_script_and_language (benchmark::State& state,
 						    hb_script_t script,
 						    const char *language_str) {
@@ -41,4 +43,48 @@ BENCHMARK_CAPTURE (BM_hb_ot_tags_from_script_and_language, LATIN en_US, HB_SCRIP
 BENCHMARK_CAPTURE (BM_hb_ot_tags_from_script_and_language, COMMON none, HB_SCRIPT_LATIN, nullptr);
 BENCHMARK_CAPTURE (BM_hb_ot_tags_from_script_and_language, LATIN none, HB_SCRIPT_LATIN, nullptr);
 
+/* Cycles through many languages, so that every lookup is a different one. */
+static void BM_hb_ot_tags_from_language_mixed (benchmark::State& state)
+{
+  const char *language_strs[] = {
+    "en", "fa", "hi", "ar", "de", "ru", "ja", "ko", "th", "vi", "he", "el",
+    "ckb", "fil", "yue", "haw", "sco", "nds", "zza", "aae", "kmr", "ast",
+  };
+  hb_language_t languages[sizeof (language_strs) / sizeof (language_strs[0])];
+  unsigned num_languages = sizeof (languages) / sizeof (languages[0]);
+  for (unsigned i = 0; i < num_languages; i++)
+    languages[i] = hb_language_from_string (language_strs[i], -1);
+
+  unsigned i = 0;
+  for (auto _ : state)
+  {
+    hb_tag_t language_tags[HB_OT_MAX_TAGS_PER_LANGUAGE];
+    unsigned language_count = HB_OT_MAX_TAGS_PER_LANGUAGE;
+
+    hb_ot_tags_from_script_and_language (HB_SCRIPT_COMMON,
+					 languages[i++ % num_languages],
+					 nullptr, nullptr,
+					 &language_count /* IN/OUT */,
+					 language_tags /* OUT */);
+  }
+}
+BENCHMARK (BM_hb_ot_tags_from_language_mixed);
+
+/* Looks up a language that was created before that many others. */
+static void BM_hb_language_from_string (benchmark::State& state)
+{
+  hb_language_from_string ("en-US", -1);
+
+  char buf[32];
+  for (unsigned i = 0; i < (unsigned) state.range (0); i++)
+  {
+    snprintf (buf, sizeof (buf), "x-bench-%d-%u", (int) state.range (0), i);
+    hb_language_from_string (buf, -1);
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize (hb_language_from_string ("en-US", -1));
+}
+BENCHMARK (BM_hb_language_from_string)->Range (1 << 4, 1 << 12);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,183 @@
+#include "benchmark/benchmark.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "hb-subset-repacker.h"
+
+/* Graphs are stored in the format used by the repacker fuzzer; see
+ * test/fuzzing/hb-repacker-fuzzer.cc. */
+#define GRAPHS_BASE_PATH "test/fuzzing/graphs/"
+
+static const char *default_graphs[] =
+{
+  GRAPHS_BASE_PATH "noto_nastaliq_urdu",
+  GRAPHS_BASE_PATH "clusterfuzz-testcase-minimized-hb-repacker-fuzzer-5196242811748352",
+};
+
+static const char **graphs = default_graphs;
+static unsigned num_graphs = sizeof (default_graphs) / sizeof (default_graphs[0]);
+
+struct link_t
+{
+  uint16_t parent;
+  uint16_t child;
+  uint16_t position;
+  uint8_t width;
+};
+
+struct graph_t
+{
+  hb_tag_t table_tag = 0;
+  unsigned num_objects = 0;
+  hb_object_t *objects = nullptr;
+
+  ~graph_t ()
+  {
+    for (unsigned i = 0; i < num_objects; i++)
+    {
+      free (objects[i].head);
+      free (objects[i].real_links);
+    }
+    free (objects);
+  }
+
+  template <typename T>
+  static bool read (const char **data, unsigned *size, T *out)
+  {
+    if (*size < sizeof (T)) return false;
+    memcpy (out, *data, sizeof (T));
+    *data += sizeof (T);
+    *size -= sizeof (T);
+    return true;
+  }
+
+  bool parse (const char *data, unsigned size)
+  {
+    uint16_t count;
+    if (!read (&data, &size, &table_tag)) return false;
+    if (!read (&data, &size, &count)) return false;
+
+    num_objects = count;
+    objects = (hb_object_t *) calloc (num_objects, sizeof (hb_object_t));
+    for (unsigned i = 0; i < num_objects; i++)
+    {
+      uint16_t blob_size;
+      if (!read (&data, &size, &blob_size) || size < blob_size) return false;
+
+      char *copy = (char *) calloc (1, blob_size);
+      memcpy (copy, data, blob_size);
+      objects[i].head = copy;
+      objects[i].tail = copy + blob_size;
+      data += blob_size;
+      size -= blob_size;
+    }
+
+    uint16_t num_links;
+    if (!read (&data, &size, &num_links)) return false;
+    link_t *links = (link_t *) calloc (num_links, sizeof (link_t));
+    unsigned *link_count = (unsigned *) calloc (num_objects, sizeof (unsigned));
+    bool ret = true;
+    for (unsigned i = 0; i < num_links; i++)
+    {
+      if (!read (&data, &size, &links[i]) || links[i].parent >= num_objects)
+      {
+        ret = false;
+        break;
+      }
+      link_count[links[i].parent]++;
+    }
+
+    if (ret)
+    {
+      for (unsigned i = 0; i < num_objects; i++)
+      {
+        objects[i].num_real_links = link_count[i];
+        objects[i].real_links = (hb_link_t *) calloc (link_count[i], sizeof (hb_link_t));
+      }
+
+      /* Links are added in reverse, as the fuzzer does. */
+      for (unsigned i = 0; i < num_links; i++)
+      {
+        unsigned parent = links[i].parent;
+        hb_link_t *link = &objects[parent].real_links[--link_count[parent]];
+        link->width = links[i].width;
+        link->position = links[i].position;
+        link->objidx = links[i].child + 1; /* Shifted by one for the null object. */
+      }
+    }
+
+    free (link_count);
+    free (links);
+    return ret;
+  }
+};
+
+/* benchmark for packing an object graph */
+static void BM_repack (benchmark::State &state,
+                       const char *graph_path)
+{
+  hb_blob_t *blob = hb_blob_create_from_file_or_fail (graph_path);
+  assert (blob);
+  unsigned size;
+  const char *data = hb_blob_get_data (blob, &size);
+
+  unsigned num_objects = 0;
+  for (auto _ : state)
+  {
+    /* The repacker writes to the objects it is given, so each iteration
+     * packs a freshly parsed copy. */
+    state.PauseTiming ();
+    graph_t *graph = new graph_t;
+    bool parsed = graph->parse (data, size);
+    assert (parsed);
+    num_objects = graph->num_objects;
+    state.ResumeTiming ();
+
+    hb_blob_t *packed = hb_subset_repack_or_fail (graph->table_tag,
+                                                  graph->objects,
+                                                  graph->num_objects);
+    benchmark::DoNotOptimize (packed);
+
+    state.PauseTiming ();
+    hb_blob_destroy (packed);
+    delete graph;
+    state.ResumeTiming ();
+  }
+
+  state.counters["objects"] = num_objects;
+  hb_blob_destroy (blob);
+}
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+
+  if (argc > 1)
+  {
+    num_graphs = argc - 1;
+    graphs = (const char **) calloc (num_graphs, sizeof (const char *));
+    for (unsigned i = 0; i < num_graphs; i++)
+      graphs[i] = argv[i + 1];
+  }
+
+  for (unsigned i = 0; i < num_graphs; i++)
+  {
+    char name[1024] = "BM_repack/";
+    const char *p = strrchr (graphs[i], '/');
+    strncat (name, p ? p + 1 : graphs[i], sizeof (name) - strlen (name) - 1);
+    benchmark::RegisterBenchmark (name, BM_repack, graphs[i])
+     ->Unit(benchmark::kMillisecond);
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  if (graphs != default_graphs)
+    free (graphs);
+}
@@ -22,8 +22,6 @@ void RandomSet(unsigned size, unsigned max_value, hb_set_t* out) {
   }
 }
 
-// TODO(garretrieger): benchmark union/subtract/intersection etc.
-
 /* Insert a 1000 values into set of varying sizes. */
 static void BM_SetInsert_1000(benchmark::State& state) {
   unsigned set_size = state.range(0);
@@ -125,6 +123,27 @@ BENCHMARK(BM_SetIteration)
         {{1 << 10, 1 << 16}, // Set Size
          {2, 512}});          // Density
 
+/* Full range iteration of sets of varying sizes. */
+static void BM_SetRangeIteration(benchmark::State& state) {
+  unsigned set_size = state.range(0);
+  unsigned max_value = state.range(0) * state.range(1);
+
+  hb_set_t* original = hb_set_create ();
+  RandomSet(set_size, max_value, original);
+  assert(hb_set_get_population(original) == set_size);
+
+  hb_codepoint_t first = HB_SET_VALUE_INVALID, last = HB_SET_VALUE_INVALID;
+  for (auto _ : state) {
+    hb_set_next_range (original, &first, &last);
+  }
+
+  hb_set_destroy(original);
+}
+BENCHMARK(BM_SetRangeIteration)
+    ->Ranges(
+        {{1 << 10, 1 << 16}, // Set Size
+         {2, 512}});          // Density
+
 /* Set copy. */
 static void BM_SetCopy(benchmark::State& state) {
   unsigned set_size = state.range(0);
@@ -148,4 +167,46 @@ BENCHMARK(BM_SetCopy)
         {{1 << 10, 1 << 16}, // Set Size
          {2, 512}});          // Density
 
+/* Set algebra between two random sets of the same size and density. */
+static void BM_SetAlgebra(benchmark::State& state,
+			  void (*op) (hb_set_t *, const hb_set_t *)) {
+  unsigned set_size = state.range(0);
+  unsigned max_value = state.range(0) * state.range(1);
+
+  hb_set_t* a = hb_set_create ();
+  RandomSet(set_size, max_value, a);
+  assert(hb_set_get_population(a) == set_size);
+
+  hb_set_t* b = hb_set_create ();
+  RandomSet(set_size, max_value + 1, b);
+
+  hb_set_t* data = hb_set_create ();
+  for (auto _ : state) {
+    state.PauseTiming ();
+    hb_set_set (data, a);
+    state.ResumeTiming ();
+    op (data, b);
+    benchmark::DoNotOptimize(hb_set_get_population (data));
+  }
+
+  hb_set_destroy(data);
+  hb_set_destroy(a);
+  hb_set_destroy(b);
+}
+BENCHMARK_CAPTURE(BM_SetAlgebra, union, hb_set_union)
+    ->Unit(benchmark::kMicrosecond)
+    ->Ranges(
+        {{1 << 10, 100000}, // Set Size
+         {2, 512}});         // Density
+BENCHMARK_CAPTURE(BM_SetAlgebra, intersect, hb_set_intersect)
+    ->Unit(benchmark::kMicrosecond)
+    ->Ranges(
+        {{1 << 10, 100000}, // Set Size
+         {2, 512}});         // Density
+BENCHMARK_CAPTURE(BM_SetAlgebra, subtract, hb_set_subtract)
+    ->Unit(benchmark::kMicrosecond)
+    ->Ranges(
+        {{1 << 10, 100000}, // Set Size
+         {2, 512}});         // Density
+
 BENCHMARK_MAIN();
@@ -164,8 +164,12 @@ struct Coverage
     ;
 
     // Cache the iterator result as it will be iterated multiple times
-    // by the serialize code below.
-    hb_sorted_vector_t<hb_codepoint_t> glyphs (it);
+    // by the serialize code below.  Size it up front since the filtered
+    // iterator's length is unknown, to avoid regrowing for every table.
+    hb_sorted_vector_t<hb_codepoint_t> glyphs;
+    glyphs.alloc (hb_min (get_population (),
+			  c->plan->glyph_map_gsub.get_population ()));
+    hb_copy (it, glyphs);
     Coverage_serialize (c->serializer, glyphs.iter ());
     return_trace (bool (glyphs));
   }
@@ -214,6 +218,74 @@ struct Coverage
     }
   }
 
+  /* Fails if the ranges are not sorted and disjoint. */
+  template <typename ranges_t>
+  bool collect_ranges (ranges_t *ranges) const
+  {
+    switch (u.format)
+    {
+    case 1: return u.format1.collect_ranges (ranges);
+    case 2: return u.format2.collect_ranges (ranges);
+#ifndef HB_NO_BEYOND_64K
+    case 3: return u.format3.collect_ranges (ranges);
+    case 4: return u.format4.collect_ranges (ranges);
+#endif
+    default:return false;
+    }
+  }
+
+  /* Number of ranges accelerator_t would be built from, read off the
+   * table without allocating.  Format 2 ranges are counted as stored,
+   * so ones continuing each other are counted more than once. */
+  unsigned get_range_count () const
+  {
+    switch (u.format)
+    {
+    case 1: return u.format1.get_range_count ();
+    case 2: return u.format2.get_range_count ();
+#ifndef HB_NO_BEYOND_64K
+    case 3: return u.format3.get_range_count ();
+    case 4: return u.format4.get_range_count ();
+#endif
+    default:return 0;
+    }
+  }
+
+  /* First and last covered glyph, as stored; fails if empty. */
+  bool get_bounds (hb_codepoint_t *first, hb_codepoint_t *last) const
+  {
+    switch (u.format)
+    {
+    case 1: return u.format1.get_bounds (first, last);
+    case 2: return u.format2.get_bounds (first, last);
+#ifndef HB_NO_BEYOND_64K
+    case 3: return u.format3.get_bounds (first, last);
+    case 4: return u.format4.get_bounds (first, last);
+#endif
+    default:return false;
+    }
+  }
+
+  /* Estimates how much of the gaps between the covered glyphs filter
+   * (such as a set digest built from this coverage) accepts. */
+  template <typename filter_t>
+  float false_positive_rate (const filter_t &filter) const
+  {
+    hb_codepoint_t lo, hi;
+    if (!get_bounds (&lo, &hi) || lo >= hi) return 0.f;
+
+    constexpr unsigned samples = 256;
+    unsigned misses = 0, passes = 0;
+    for (unsigned i = 0; i < samples; i++)
+    {
+      hb_codepoint_t g = lo + (hb_codepoint_t) ((uint64_t) (hi - lo) * i / (samples - 1));
+      if (has (g)) continue;
+      misses++;
+      passes += filter.may_have (g);
+    }
+    return misses ? (float) passes / misses : 0.f;
+  }
+
   template <typename IterableOut,
 	    hb_requires (hb_is_sink_of (IterableOut, hb_codepoint_t))>
   void intersect_set (const hb_set_t &glyphs, IterableOut&& intersect_glyphs) const
@@ -333,6 +405,92 @@ struct Coverage
     } u;
   };
   iter_t iter () const { return iter_t (*this); }
+
+  /* Native-endian copy of the coverage ranges, stored in Eytzinger
+   * (breadth-first) order.  Membership tests descend the implicit tree
+   * with no data-dependent branches, and the top levels that every
+   * search touches share a few cache lines.  Built by the lookup
+   * accelerators for large coverages. */
+  struct accelerator_t
+  {
+    struct range_t
+    {
+      hb_codepoint_t last;
+      hb_codepoint_t first;
+      unsigned delta; /* Coverage index minus glyph, modulo 2^32. */
+    };
+
+    /* Fails, leaving the accelerator empty, if the coverage is malformed. */
+    bool init (const Coverage &coverage)
+    {
+      sorted_ranges_t ranges;
+      if (unlikely (!coverage.collect_ranges (&ranges) ||
+		    ranges.in_error () ||
+		    !tree.resize (ranges.length + 1, false)))
+      {
+	fini ();
+	return false;
+      }
+
+      tree.arrayZ[0] = {0, 0, 0};
+      fill (ranges.arrayZ, 0, 1);
+      return true;
+    }
+    void fini () { tree.fini (); }
+
+    bool is_empty () const { return !tree.length; }
+    unsigned get_range_count () const { return tree.length ? tree.length - 1 : 0; }
+
+    /* Same result as Coverage::get_coverage(). */
+    unsigned get_coverage (hb_codepoint_t g) const
+    {
+      const range_t *t = tree.arrayZ;
+      unsigned n = tree.length;
+      unsigned k = 1;
+      /* Find the first range ending at or after g... */
+      while (k < n)
+	k = 2 * k + (t[k].last < g);
+      /* ...by undoing the right-turns taken past it. */
+      k >>= hb_ctz (~k) + 1;
+      return k && t[k].first <= g ? g + t[k].delta : NOT_COVERED;
+    }
+    bool has (hb_codepoint_t g) const { return get_coverage (g) != NOT_COVERED; }
+
+    private:
+    struct sorted_ranges_t : hb_vector_t<range_t>
+    {
+      bool add_range (hb_codepoint_t first, hb_codepoint_t last, unsigned index)
+      {
+	if (unlikely (first > last)) return false;
+	unsigned delta = index - first;
+	if (this->length)
+	{
+	  range_t &prev = this->tail ();
+	  if (unlikely (first <= prev.last)) return false;
+	  if (first == prev.last + 1 && delta == prev.delta)
+	  {
+	    prev.last = last;
+	    return true;
+	  }
+	}
+	this->push (range_t {last, first, delta});
+	return true;
+      }
+    };
+
+    unsigned fill (const range_t *sorted, unsigned i, unsigned k)
+    {
+      if (k < tree.length)
+      {
+	i = fill (sorted, i, 2 * k);
+	tree.arrayZ[k] = sorted[i++];
+	i = fill (sorted, i, 2 * k + 1);
+      }
+      return i;
+    }
+
+    hb_vector_t<range_t> tree;
+  };
 };
 
 template<typename Iterator>
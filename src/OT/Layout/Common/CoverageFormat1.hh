@@ -107,6 +107,33 @@ struct CoverageFormat1_3
   bool collect_coverage (set_t *glyphs) const
   { return glyphs->add_sorted_array (glyphArray.as_array ()); }
 
+  template <typename ranges_t>
+  bool collect_ranges (ranges_t *ranges) const
+  {
+    unsigned count = glyphArray.len;
+    for (unsigned i = 0; i < count; i++)
+      if (unlikely (!ranges->add_range (glyphArray.arrayZ[i], glyphArray.arrayZ[i], i)))
+        return false;
+    return true;
+  }
+
+  unsigned get_range_count () const
+  {
+    unsigned count = glyphArray.len;
+    unsigned ranges = count ? 1 : 0;
+    for (unsigned i = 1; i < count; i++)
+      ranges += glyphArray.arrayZ[i] != glyphArray.arrayZ[i - 1] + 1;
+    return ranges;
+  }
+
+  bool get_bounds (hb_codepoint_t *first, hb_codepoint_t *last) const
+  {
+    if (unlikely (!glyphArray.len)) return false;
+    *first = glyphArray.arrayZ[0];
+    *last = glyphArray.arrayZ[glyphArray.len - 1];
+    return true;
+  }
+
   public:
   /* Older compilers need this to be public. */
   struct iter_t
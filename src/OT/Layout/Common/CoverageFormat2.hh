@@ -166,6 +166,25 @@ struct CoverageFormat2_4
     return true;
   }
 
+  template <typename ranges_t>
+  bool collect_ranges (ranges_t *ranges) const
+  {
+    for (const auto& range: rangeRecord)
+      if (unlikely (!ranges->add_range (range.first, range.last, range.value)))
+        return false;
+    return true;
+  }
+
+  unsigned get_range_count () const { return rangeRecord.len; }
+
+  bool get_bounds (hb_codepoint_t *first, hb_codepoint_t *last) const
+  {
+    if (unlikely (!rangeRecord.len)) return false;
+    *first = rangeRecord.arrayZ[0].first;
+    *last = rangeRecord.arrayZ[rangeRecord.len - 1].last;
+    return true;
+  }
+
   public:
   /* Older compilers need this to be public. */
   struct iter_t
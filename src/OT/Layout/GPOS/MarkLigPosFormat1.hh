@@ -96,7 +96,7 @@ struct MarkLigPosFormat1_2
   {
     TRACE_APPLY (this);
     hb_buffer_t *buffer = c->buffer;
-    unsigned int mark_index = (this+markCoverage).get_coverage  (buffer->cur().codepoint);
+    unsigned int mark_index = c->get_coverage_index (this+markCoverage);
     if (likely (mark_index == NOT_COVERED)) return_trace (false);
 
     /* Now we search backwards for a non-mark glyph */
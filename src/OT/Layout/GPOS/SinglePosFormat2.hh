@@ -65,7 +65,7 @@ struct SinglePosFormat2
   {
     TRACE_APPLY (this);
     hb_buffer_t *buffer = c->buffer;
-    unsigned int index = (this+coverage).get_coverage  (buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     if (unlikely (index >= valueCount)) return_trace (false);
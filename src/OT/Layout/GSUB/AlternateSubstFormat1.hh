@@ -73,7 +73,7 @@ struct AlternateSubstFormat1_2
   {
     TRACE_APPLY (this);
 
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     return_trace ((this+alternateSet[index]).apply (c));
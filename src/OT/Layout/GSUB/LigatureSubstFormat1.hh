@@ -82,7 +82,7 @@ struct LigatureSubstFormat1_2
   {
     TRACE_APPLY (this);
 
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur ().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const auto &lig_set = this+ligatureSet[index];
@@ -448,7 +448,8 @@ glyf::_populate_subset_glyphs (const hb_subset_plan_t   *plan,
     {
       /* If plan has an accelerator, the preprocessing step already trimmed glyphs.
        * Don't trim them again! */
-      subset_glyph.source_glyph = glyf.glyph_for_gid (subset_glyph.old_gid, !plan->accelerator);
+      subset_glyph.source_glyph = glyf.glyph_for_gid (subset_glyph.old_gid,
+						      !(plan->accelerator && plan->accelerator->glyf_trimmed));
     }
 
     if (plan->flags & HB_SUBSET_FLAGS_NO_HINTING)
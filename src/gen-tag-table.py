@@ -943,15 +943,76 @@ def get_matching_language_name (intersection, candidates):
 def same_tag (bcp_47_tag, ot_tags):
 	return len (bcp_47_tag) == 3 and len (ot_tags) == 1 and bcp_47_tag == ot_tags[0].lower ()
 
+def language_hash (language):
+	"""Hashes a language tag for ``make_perfect_hash``.
+
+	Args:
+		language (int): The language as an ``hb_tag_t``.
+
+	Returns:
+		The 32-bit hash; ot_languages_lookup() in hb-ot-tag.cc computes the same.
+	"""
+	h = (language * 0x9E3779B1) & 0xFFFFFFFF
+	return h ^ (h >> 15)
+
+def make_perfect_hash (keys, seed_bits, slot_bits):
+	"""Builds a hash-and-displace perfect hash.
+
+	Each key picks a bucket from the top ``seed_bits`` bits of its hash.
+	Buckets are placed largest first, each with the smallest seed that
+	puts all of its keys into free slots.
+
+	Args:
+		keys (list[tuple[int, int]]): Pairs of (language, value), where
+			every value is nonzero.
+		seed_bits (int): The log2 of the number of buckets.
+		slot_bits (int): The log2 of the number of slots.
+
+	Returns:
+		The seed for each bucket and the value in each slot, with 0 for
+		empty slots.
+	"""
+	buckets = [[] for _ in range (1 << seed_bits)]
+	for language, value in keys:
+		h = language_hash (language)
+		buckets[h >> (32 - seed_bits)].append ((h, value))
+	seeds = [0] * len (buckets)
+	slots = [0] * (1 << slot_bits)
+	for bucket in sorted (range (len (buckets)), key=lambda b: -len (buckets[b])):
+		if not buckets[bucket]:
+			break
+		for seed in range (256):
+			positions = [(((h ^ seed) * 0x2C1B3C6D) & 0xFFFFFFFF) >> (32 - slot_bits)
+				     for h, _ in buckets[bucket]]
+			if len (set (positions)) == len (positions) and not any (slots[p] for p in positions):
+				break
+		else:
+			raise ValueError ('Cannot build a perfect hash with %d seed bits and %d slot bits' % (seed_bits, slot_bits))
+		seeds[bucket] = seed
+		for p, (_, value) in zip (positions, buckets[bucket]):
+			slots[p] = value
+	return seeds, slots
+
+def print_array (c_type, name, values):
+	print ('static const %s %s[] = {' % (c_type, name))
+	for i in range (0, len (values), 16):
+		print ('  %s,' % ', '.join (str (v) for v in values[i:i + 16]))
+	print ('};')
+
 for language_len in (2, 3):
 	if language_len == 3:
 		print ('#ifndef HB_NO_LANGUAGE_LONG')
 	print ('static const LangTag ot_languages%d[] = {' % language_len)
+	row = 0
+	hash_keys = []
 	for language, tags in sorted (ot.from_bcp_47.items ()):
 		if language == '' or '-' in language:
 			continue
 		if len(language) != language_len: continue
 		commented_out = same_tag (language, tags)
+		if not commented_out:
+			hash_keys.append ((int.from_bytes (language.ljust (4).encode (), 'big'), row + 1))
+			row += len (tags)
 		for i, tag in enumerate (tags, start=1):
 			print ('%s{%s,\t%s},' % ('/*' if commented_out else '  ', hb_tag (language), hb_tag (tag)), end='')
 			if commented_out:
@@ -973,6 +1034,12 @@ for language_len in (2, 3):
 					write ('%s%s' % (name if len (name) > len (ot_name) else ot_name, scope))
 			print (' */')
 	print ('};')
+	print ()
+	print ('/* Perfect hash from language to the index + 1 of its first row in')
+	print (' * ot_languages%d.  See ot_languages_lookup(). */' % language_len)
+	seeds, slots = make_perfect_hash (hash_keys, *{2: (6, 8), 3: (8, 11)}[language_len])
+	print_array ('uint8_t', 'ot_languages%d_hash_seeds' % language_len, seeds)
+	print_array ('uint16_t', 'ot_languages%d_hash_slots' % language_len, slots)
 	if language_len == 3:
 		print ('#endif')
 	print ()
@@ -77,6 +77,46 @@ dm_order = {None: 0}
 dm_order.update(dm1_order)
 dm_order.update(dm2_order)
 
+# Composition looks up (a,b) pairs through a perfect hash into the dm2
+# arrays, instead of binary-searching them.  Only pairs that actually
+# compose (ie. not composition exclusions) are in the hash.  Each key
+# picks a bucket from the top bits of its hash; the bucket's seed is
+# then chosen such that all keys in it land in free slots.  Slots hold
+# dm2 index + 1, or 0 if empty.  See hb_ucd_compose() for the lookup,
+# which must use the same constants.
+
+def compose_hash(a, b):
+    h = ((a * 0x9E3779B1) ^ (b * 0x85EBCA77)) & 0xFFFFFFFF
+    return h ^ (h >> 15)
+
+dm2_hash_seed_bits = 9
+dm2_hash_slot_bits = 10
+
+def compose_hash_slot(h, seed):
+    return (((h ^ seed) * 0x2C1B3C6D) & 0xFFFFFFFF) >> (32 - dm2_hash_slot_bits)
+
+dm2_hash_buckets = [[] for _ in range(1 << dm2_hash_seed_bits)]
+for i,v in enumerate(dm2):
+    a, b, ab = v[0]
+    if not ab: continue
+    h = compose_hash(a, b)
+    dm2_hash_buckets[h >> (32 - dm2_hash_seed_bits)].append((h, i + 1))
+
+dm2_hash_seed_array = [0] * len(dm2_hash_buckets)
+dm2_hash_map_array = [0] * (1 << dm2_hash_slot_bits)
+for bucket in sorted(range(len(dm2_hash_buckets)), key=lambda k: -len(dm2_hash_buckets[k])):
+    keys = dm2_hash_buckets[bucket]
+    if not keys: break
+    for seed in range(256):
+        slots = [compose_hash_slot(h, seed) for h,_ in keys]
+        if len(set(slots)) == len(slots) and not any(dm2_hash_map_array[s] for s in slots):
+            break
+    else:
+        assert False, "Failed to build composition hash; adjust sizes."
+    dm2_hash_seed_array[bucket] = seed
+    for s,(_,i) in zip(slots, keys):
+        dm2_hash_map_array[s] = i
+
 
 # Prepare General_Category / Script mapping arrays
 
@@ -138,6 +178,8 @@ dm1_p0_array, _ = code.addArray('uint16_t', 'dm1_p0_map', dm1_p0_array)
 dm1_p2_array, _ = code.addArray('uint16_t', 'dm1_p2_map', dm1_p2_array)
 dm2_u32_array, _ = code.addArray('uint32_t', 'dm2_u32_map', dm2_u32_array)
 dm2_u64_array, _ = code.addArray('uint64_t', 'dm2_u64_map', dm2_u64_array)
+dm2_hash_seed_array, _ = code.addArray('uint8_t', 'dm2_hash_seed', dm2_hash_seed_array)
+dm2_hash_map_array, _ = code.addArray('uint16_t', 'dm2_hash_map', dm2_hash_map_array)
 code.print_c(linkage='static inline')
 
 datasets = [
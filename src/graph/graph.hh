@@ -44,7 +44,7 @@ struct graph_t
     hb_serialize_context_t::object_t obj;
     int64_t distance = 0 ;
     int64_t space = 0 ;
-    hb_vector_t<unsigned> parents;
+    hb_small_vector_t<unsigned, 2> parents;
     unsigned start = 0;
     unsigned end = 0;
     unsigned priority = 0;
@@ -216,6 +216,20 @@ struct graph_t
       }
     }
 
+    // Like remap_parent () but only rewrites the first matching entry.
+    void remap_one_parent (unsigned old_index, unsigned new_index)
+    {
+      unsigned count = parents.length;
+      for (unsigned i = 0; i < count; i++)
+      {
+        if (parents.arrayZ[i] == old_index)
+        {
+          parents.arrayZ[i] = new_index;
+          return;
+        }
+      }
+    }
+
     bool is_leaf () const
     {
       return !obj.real_links.length && !obj.virtual_links.length;
@@ -326,6 +340,7 @@ struct graph_t
         distance_invalid (true),
         positions_invalid (true),
         successful (true),
+        sorted_length_ (0),
         buffers ()
   {
     num_roots_for_space_.push (1);
@@ -414,6 +429,7 @@ struct graph_t
                  unsigned parent_id,
                  unsigned child_id)
   {
+    sorted_length_ = 0;
     auto& v = vertices_[parent_id];
     auto* link = v.obj.real_links.push ();
     link->width = 2;
@@ -447,57 +463,33 @@ struct graph_t
     }
 
     update_distances ();
+    sort_by_distance (false);
+  }
 
-    hb_priority_queue_t queue;
-    hb_vector_t<vertex_t> &sorted_graph = vertices_scratch_;
-    if (unlikely (!check_success (sorted_graph.resize (vertices_.length)))) return;
-    hb_vector_t<unsigned> id_map;
-    if (unlikely (!check_success (id_map.resize (vertices_.length)))) return;
-
-    hb_vector_t<unsigned> removed_edges;
-    if (unlikely (!check_success (removed_edges.resize (vertices_.length)))) return;
-    update_parents ();
-
-    queue.insert (root ().modified_distance (0), root_idx ());
-    int new_id = root_idx ();
-    unsigned order = 1;
-    while (!queue.in_error () && !queue.is_empty ())
+  /*
+   * Same as sort_shortest_distance (), for a graph that has only been
+   * changed through duplicate (), isolate_subgraph (), move_to_new_space ()
+   * and raise_childrens_priority () since it was last sorted. Only the
+   * distances in the subgraphs of the changed nodes are recomputed, and
+   * the previous sorting is followed for as long as the changes make no
+   * difference to it, instead of sorting everything again.
+   */
+  void sort_shortest_distance_incremental ()
+  {
+    if (!sorted_length_
+        || parents_invalid
+        || changed_nodes_.in_error ()
+        // Beyond this the order tie-breaker in modified_distance () wraps
+        // around, so only a full sort is guaranteed to give the same result.
+        || vertices_.length > 0x003FFFF)
     {
-      unsigned next_id = queue.pop_minimum().second;
-
-      hb_swap (sorted_graph[new_id], vertices_[next_id]);
-      const vertex_t& next = sorted_graph[new_id];
-
-      if (unlikely (!check_success(new_id >= 0))) {
-        // We are out of ids. Which means we've visited a node more than once.
-        // This graph contains a cycle which is not allowed.
-        DEBUG_MSG (SUBSET_REPACK, nullptr, "Invalid graph. Contains cycle.");
-        return;
-      }
-
-      id_map[next_id] = new_id--;
-
-      for (const auto& link : next.obj.all_links ()) {
-        removed_edges[link.objidx]++;
-        if (!(vertices_[link.objidx].incoming_edges () - removed_edges[link.objidx]))
-          // Add the order that the links were encountered to the priority.
-          // This ensures that ties between priorities objects are broken in a consistent
-          // way. More specifically this is set up so that if a set of objects have the same
-          // distance they'll be added to the topological order in the order that they are
-          // referenced from the parent object.
-          queue.insert (vertices_[link.objidx].modified_distance (order++),
-                        link.objidx);
-      }
+      sort_shortest_distance ();
+      return;
     }
 
-    check_success (!queue.in_error ());
-    check_success (!sorted_graph.in_error ());
-
-    remap_all_obj_indices (id_map, &sorted_graph);
-    hb_swap (vertices_, sorted_graph);
-
-    if (!check_success (new_id == -1))
-      print_orphaned_nodes ();
+    positions_invalid = true;
+    update_changed_distances ();
+    sort_by_distance (true);
   }
 
   /*
@@ -623,6 +615,7 @@ struct graph_t
    */
   bool assign_spaces ()
   {
+    sorted_length_ = 0;
     update_parents ();
 
     hb_set_t visited;
@@ -812,6 +805,7 @@ struct graph_t
   {
     distance_invalid = true;
     positions_invalid = true;
+    sorted_length_ = 0;
 
     auto& old_v = vertices_[old_parent_idx];
     auto& new_v = vertices_[new_parent_idx];
@@ -876,11 +870,13 @@ struct graph_t
     {
       clone->obj.real_links.push (l);
       vertices_[l.objidx].parents.push (clone_idx);
+      record_node_change (l.objidx);
     }
     for (const auto& l : child.obj.virtual_links)
     {
       clone->obj.virtual_links.push (l);
       vertices_[l.objidx].parents.push (clone_idx);
+      record_node_change (l.objidx);
     }
 
     check_success (!clone->obj.real_links.in_error ());
@@ -892,8 +888,10 @@ struct graph_t
     hb_swap (vertices_[vertices_.length - 2], *clone);
 
     // Since the root moved, update the parents arrays of all children on the root.
+    // A child of both the root and the clone has parent entries for each under the
+    // same index, so only rewrite one entry per link from the root.
     for (const auto& l : root ().obj.all_links ())
-      vertices_[l.objidx].remap_parent (root_idx () - 1, root_idx ());
+      vertices_[l.objidx].remap_one_parent (root_idx () - 1, root_idx ());
 
     return clone_idx;
   }
@@ -963,6 +961,7 @@ struct graph_t
   {
     positions_invalid = true;
     distance_invalid = true;
+    sorted_length_ = 0;
 
     auto* clone = vertices_.push ();
     if (vertices_.in_error ()) {
@@ -1001,7 +1000,11 @@ struct graph_t
     auto& parent = vertices_[parent_idx].obj;
     bool made_change = false;
     for (auto& l : parent.all_links_writer ())
-      made_change |= vertices_[l.objidx].raise_priority ();
+    {
+      if (!vertices_[l.objidx].raise_priority ()) continue;
+      record_node_change (l.objidx);
+      made_change = true;
+    }
     return made_change;
   }
 
@@ -1113,6 +1116,7 @@ struct graph_t
       node.space = new_space;
       distance_invalid = true;
       positions_invalid = true;
+      record_node_change (index);
     }
   }
 
@@ -1241,12 +1245,10 @@ struct graph_t
     // https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
     //
     // Implementation Note:
-    // Since our priority queue doesn't support fast priority decreases
-    // we instead just add new entries into the queue when a priority changes.
-    // Redundant ones are filtered out later on by the visited set.
-    // According to https://www3.cs.stonybrook.edu/~rezaul/papers/TR-07-54.pdf
-    // for practical performance this is faster then using a more advanced queue
-    // (such as a fibonacci queue) with a fast decrease priority.
+    // The queue is indexed by vertex, so when a shorter distance is found
+    // the vertex's existing entry is moved up instead of a duplicate entry
+    // being added. That keeps the queue no larger than the number of
+    // vertices and means every vertex is popped exactly once.
     unsigned count = vertices_.length;
     for (unsigned i = 0; i < count; i++)
     {
@@ -1256,7 +1258,7 @@ struct graph_t
         vertices_.arrayZ[i].distance = hb_int_max (int64_t);
     }
 
-    hb_priority_queue_t queue;
+    hb_indexed_priority_queue_t queue;
     queue.insert (0, vertices_.length - 1);
 
     hb_vector_t<bool> visited;
@@ -1265,7 +1267,6 @@ struct graph_t
     while (!queue.in_error () && !queue.is_empty ())
     {
       unsigned next_idx = queue.pop_minimum ().second;
-      if (visited[next_idx]) continue;
       const auto& next = vertices_[next_idx];
       int64_t next_distance = vertices_[next_idx].distance;
       visited[next_idx] = true;
@@ -1274,16 +1275,12 @@ struct graph_t
       {
         if (visited[link.objidx]) continue;
 
-        const auto& child = vertices_[link.objidx].obj;
-        unsigned link_width = link.width ? link.width : 4; // treat virtual offsets as 32 bits wide
-        int64_t child_weight = (child.tail - child.head) +
-                               ((int64_t) 1 << (link_width * 8)) * (vertices_[link.objidx].space + 1);
-        int64_t child_distance = next_distance + child_weight;
+        int64_t child_distance = next_distance + link_weight (link);
 
         if (child_distance < vertices_[link.objidx].distance)
         {
           vertices_[link.objidx].distance = child_distance;
-          queue.insert (child_distance, link.objidx);
+          queue.decrease_priority (child_distance, link.objidx);
         }
       }
     }
@@ -1299,6 +1296,260 @@ struct graph_t
   }
 
  private:
+  int64_t link_weight (const hb_serialize_context_t::object_t::link_t& link) const
+  {
+    const auto& child = vertices_[link.objidx].obj;
+    unsigned link_width = link.width ? link.width : 4; // treat virtual offsets as 32 bits wide
+    return (child.tail - child.head) +
+           ((int64_t) 1 << (link_width * 8)) * (vertices_[link.objidx].space + 1);
+  }
+
+  /*
+   * Recomputes the distances of the changed and new nodes and everything
+   * reachable from them; no other distance can have changed. Nodes whose
+   * distance did change are recorded as changed.
+   */
+  void update_changed_distances ()
+  {
+    unsigned count = vertices_.length;
+    hb_vector_t<unsigned> affected;
+    hb_vector_t<uint8_t> state; // 1: affected, 2: unaffected parent of an affected node.
+    if (unlikely (!check_success (state.resize (count)))) return;
+
+    hb_vector_t<unsigned> stack;
+    for (unsigned i : changed_nodes_)
+      stack.push (i);
+    for (unsigned i = sorted_length_ - 1; i < count - 1; i++)
+      stack.push (i);
+
+    while (stack)
+    {
+      unsigned idx = stack.pop ();
+      if (state.arrayZ[idx]) continue;
+      state.arrayZ[idx] = 1;
+      affected.push (idx);
+      for (const auto& link : vertices_.arrayZ[idx].obj.all_links ())
+        if (!state.arrayZ[link.objidx])
+          stack.push (link.objidx);
+    }
+    if (unlikely (!check_success (!stack.in_error () && !affected.in_error ()))) return;
+
+    hb_vector_t<int64_t> old_distances;
+    if (unlikely (!check_success (old_distances.resize (affected.length)))) return;
+    for (unsigned i = 0; i < affected.length; i++)
+    {
+      auto& v = vertices_.arrayZ[affected.arrayZ[i]];
+      old_distances.arrayZ[i] = v.distance;
+      v.distance = hb_int_max (int64_t);
+    }
+
+    // Same as update_distances (), but starting from the distances of the
+    // unaffected parents.
+    hb_indexed_priority_queue_t queue;
+    for (unsigned idx : affected)
+    {
+      for (unsigned p : vertices_.arrayZ[idx].parents)
+      {
+        if (state.arrayZ[p]) continue;
+        state.arrayZ[p] = 2;
+
+        const auto& parent = vertices_.arrayZ[p];
+        for (const auto& link : parent.obj.all_links ())
+        {
+          if (state.arrayZ[link.objidx] != 1) continue;
+          int64_t child_distance = parent.distance + link_weight (link);
+          auto& child = vertices_.arrayZ[link.objidx];
+          if (child_distance < child.distance)
+          {
+            child.distance = child_distance;
+            queue.decrease_priority (child_distance, link.objidx);
+          }
+        }
+      }
+    }
+
+    while (!queue.in_error () && !queue.is_empty ())
+    {
+      unsigned next_idx = queue.pop_minimum ().second;
+      const auto& next = vertices_.arrayZ[next_idx];
+      state.arrayZ[next_idx] = 0; // Visited.
+
+      for (const auto& link : next.obj.all_links ())
+      {
+        if (state.arrayZ[link.objidx] != 1) continue;
+
+        int64_t child_distance = next.distance + link_weight (link);
+        auto& child = vertices_.arrayZ[link.objidx];
+        if (child_distance < child.distance)
+        {
+          child.distance = child_distance;
+          queue.decrease_priority (child_distance, link.objidx);
+        }
+      }
+    }
+    if (unlikely (!check_success (!queue.in_error ()))) return;
+
+    for (unsigned i = 0; i < affected.length; i++)
+      if (vertices_.arrayZ[affected.arrayZ[i]].distance != old_distances.arrayZ[i])
+        changed_nodes_.add (affected.arrayZ[i]);
+
+    distance_invalid = false;
+  }
+
+  /*
+   * Returns the step of the last sort that node index was placed at (the
+   * root at step 0), or -1 if it was added since.
+   */
+  unsigned sorted_step (unsigned index) const
+  {
+    if (index == root_idx ()) return 0;
+    if (index + 1 < sorted_length_) return sorted_length_ - 1 - index;
+    return (unsigned) -1;
+  }
+
+  /*
+   * Sorts the graph as described in sort_shortest_distance (); distances must
+   * be up to date.
+   *
+   * If incremental is set, the order of the last sort is followed for as
+   * long as it provably comes out the same: the nodes queued at the same
+   * step as then, with unchanged sort keys, keep their relative order, so
+   * the next node of the last sort comes next again if it is one of them,
+   * unless a node queued differently sorts before it. Only the latter go
+   * through the queue until then.
+   */
+  void sort_by_distance (bool incremental)
+  {
+    hb_priority_queue_t queue;
+    hb_vector_t<vertex_t> &sorted_graph = vertices_scratch_;
+    if (unlikely (!check_success (sorted_graph.resize (vertices_.length)))) return;
+    hb_vector_t<unsigned> id_map;
+    if (unlikely (!check_success (id_map.resize (vertices_.length)))) return;
+
+    hb_vector_t<unsigned> removed_edges;
+    if (unlikely (!check_success (removed_edges.resize (vertices_.length)))) return;
+    hb_vector_t<unsigned> queued_steps;
+    if (unlikely (!check_success (queued_steps.resize (vertices_.length)))) return;
+    update_parents ();
+
+    int new_id = root_idx ();
+    unsigned order = 1;
+    unsigned step = 0;
+    queue.insert (root ().modified_distance (0), root_idx ());
+
+    if (incremental)
+    {
+      enum { CHANGED = 1, QUEUED_UNCHANGED = 2, PLACED = 4 };
+      hb_vector_t<uint8_t> state;
+      hb_vector_t<unsigned> orders;
+      hb_vector_t<unsigned> queued_unchanged;
+      if (unlikely (!check_success (state.resize (vertices_.length) &&
+                                    orders.resize (vertices_.length))))
+        return;
+      for (unsigned i : changed_nodes_)
+        state.arrayZ[i] = CHANGED;
+
+      queue.pop_minimum ();
+      for (; step < sorted_length_; step++)
+      {
+        unsigned next_id = step ? sorted_length_ - 1 - step : root_idx ();
+        if (step
+            && (!(state.arrayZ[next_id] & QUEUED_UNCHANGED)
+                || (!queue.is_empty ()
+                    && queue.minimum ().first < vertices_[next_id].modified_distance (orders.arrayZ[next_id]))))
+          break;
+
+        state.arrayZ[next_id] |= PLACED;
+        hb_swap (sorted_graph[new_id], vertices_[next_id]);
+        const vertex_t& next = sorted_graph[new_id];
+        id_map[next_id] = new_id--;
+
+        for (const auto& link : next.obj.all_links ()) {
+          removed_edges[link.objidx]++;
+          if (vertices_[link.objidx].incoming_edges () - removed_edges[link.objidx])
+            continue;
+
+          queued_steps[link.objidx] = step;
+          if (!(state.arrayZ[link.objidx] & CHANGED)
+              && sorted_step (link.objidx) != (unsigned) -1
+              && queued_steps_[link.objidx] == step)
+          {
+            state.arrayZ[link.objidx] |= QUEUED_UNCHANGED;
+            orders.arrayZ[link.objidx] = order++;
+            queued_unchanged.push (link.objidx);
+            continue;
+          }
+          queue.insert (vertices_[link.objidx].modified_distance (order++),
+                        link.objidx);
+        }
+      }
+
+      for (unsigned idx : queued_unchanged)
+        if (!(state.arrayZ[idx] & PLACED))
+          queue.insert (vertices_[idx].modified_distance (orders.arrayZ[idx]), idx);
+      check_success (!queued_unchanged.in_error ());
+    }
+
+    while (!queue.in_error () && !queue.is_empty ())
+    {
+      unsigned next_id = queue.pop_minimum().second;
+
+      hb_swap (sorted_graph[new_id], vertices_[next_id]);
+      const vertex_t& next = sorted_graph[new_id];
+
+      if (unlikely (!check_success(new_id >= 0))) {
+        // We are out of ids. Which means we've visited a node more than once.
+        // This graph contains a cycle which is not allowed.
+        DEBUG_MSG (SUBSET_REPACK, nullptr, "Invalid graph. Contains cycle.");
+        return;
+      }
+
+      id_map[next_id] = new_id--;
+
+      for (const auto& link : next.obj.all_links ()) {
+        removed_edges[link.objidx]++;
+        if (!(vertices_[link.objidx].incoming_edges () - removed_edges[link.objidx]))
+        {
+          // Add the order that the links were encountered to the priority.
+          // This ensures that ties between priorities objects are broken in a consistent
+          // way. More specifically this is set up so that if a set of objects have the same
+          // distance they'll be added to the topological order in the order that they are
+          // referenced from the parent object.
+          queued_steps[link.objidx] = step;
+          queue.insert (vertices_[link.objidx].modified_distance (order++),
+                        link.objidx);
+        }
+      }
+      step++;
+    }
+
+    check_success (!queue.in_error ());
+    check_success (!sorted_graph.in_error ());
+
+    remap_all_obj_indices (id_map, &sorted_graph);
+    hb_swap (vertices_, sorted_graph);
+
+    if (!check_success (new_id == -1))
+    {
+      print_orphaned_nodes ();
+      return;
+    }
+
+    if (unlikely (!check_success (queued_steps_.resize (vertices_.length)))) return;
+    for (unsigned i = 0; i < vertices_.length; i++)
+      queued_steps_.arrayZ[id_map.arrayZ[i]] = queued_steps.arrayZ[i];
+    changed_nodes_.clear ();
+    sorted_length_ = vertices_.length;
+  }
+
+  /*
+   * Records changes for sort_shortest_distance_incremental ().
+   */
+  void record_node_change (unsigned index)
+  {
+    if (sorted_length_) changed_nodes_.add (index);
+  }
+
   /*
    * Updates a link in the graph to point to a different object. Corrects the
    * parents vector on the previous and new child nodes.
@@ -1311,6 +1562,8 @@ struct graph_t
     link.objidx = new_idx;
     vertices_[old_idx].remove_parent (parent_idx);
     vertices_[new_idx].parents.push (parent_idx);
+    record_node_change (old_idx);
+    record_node_change (new_idx);
   }
 
   /*
@@ -1393,6 +1646,13 @@ struct graph_t
   bool distance_invalid;
   bool positions_invalid;
   bool successful;
+  // The number of nodes as of the last sort, or zero if the graph has since
+  // been changed in ways sort_shortest_distance_incremental () can't track.
+  unsigned sorted_length_;
+  // Nodes whose parents, space, priority or distance changed since the last sort.
+  hb_set_t changed_nodes_;
+  // The step of the last sort at which each node was queued.
+  hb_vector_t<unsigned> queued_steps_;
   hb_vector_t<unsigned> num_roots_for_space_;
   hb_vector_t<char*> buffers;
 };
@@ -1,5 +1,6 @@
 #include "hb-aat-layout.cc"
 #include "hb-aat-map.cc"
+#include "hb-allocator.cc"
 #include "hb-blob.cc"
 #include "hb-buffer-serialize.cc"
 #include "hb-buffer-verify.cc"
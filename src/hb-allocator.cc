@@ -0,0 +1,178 @@
+/*
+ * Copyright © 2023  The HarfBuzz Authors
+ *
+ *  This is part of HarfBuzz, a text shaping library.
+ *
+ * Permission is hereby granted, without written agreement and without
+ * license or royalty fees, to use, copy, modify, and distribute this
+ * software and its documentation for any purpose, provided that the
+ * above copyright notice and the following two paragraphs appear in
+ * all copies of this software.
+ *
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES
+ * ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN
+ * IF THE COPYRIGHT HOLDER HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+ * DAMAGE.
+ *
+ * THE COPYRIGHT HOLDER SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE COPYRIGHT HOLDER HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ */
+
+#include "hb-allocator.hh"
+
+
+/**
+ * SECTION:hb-allocator
+ * @title: hb-allocator
+ * @short_description: Custom memory allocators
+ * @include: hb.h
+ *
+ * Allocator objects let clients supply the memory for the glyph info
+ * and position arrays of an #hb_buffer_t, for example to serve each
+ * request's buffers from an arena that is released in bulk.
+ *
+ * Buffers are the only objects that take an allocator.  Faces, fonts,
+ * shape plans, subset inputs and subset plans, and everything cached on
+ * them, always use the library-wide allocator.
+ **/
+
+
+/**
+ * hb_allocator_create:
+ * @func: (closure user_data) (destroy destroy) (scope notified): The allocation callback
+ * @user_data: Data to pass to @func
+ * @destroy: (nullable): A callback to call when @user_data is not needed anymore
+ *
+ * Creates a new allocator that allocates, resizes and frees memory
+ * with @func.
+ *
+ * Return value: (transfer full): The new #hb_allocator_t.  If memory for the
+ * allocator itself cannot be allocated, the empty allocator, which uses the
+ * library-wide allocator, is returned instead.
+ *
+ * Since: REPLACEME
+ **/
+hb_allocator_t *
+hb_allocator_create (hb_allocator_func_t  func,
+		     void                *user_data,
+		     hb_destroy_func_t    destroy)
+{
+  hb_allocator_t *allocator;
+
+  if (unlikely (!func) ||
+      !(allocator = hb_object_create<hb_allocator_t> ()))
+  {
+    if (destroy)
+      destroy (user_data);
+    return hb_allocator_get_empty ();
+  }
+
+  allocator->func = func;
+  allocator->user_data = user_data;
+  allocator->destroy = destroy;
+
+  return allocator;
+}
+
+/**
+ * hb_allocator_get_empty:
+ *
+ * Fetches the singleton empty allocator, which uses the library-wide
+ * allocator.
+ *
+ * Return value: (transfer full): The empty #hb_allocator_t
+ *
+ * Since: REPLACEME
+ **/
+hb_allocator_t *
+hb_allocator_get_empty ()
+{
+  return const_cast<hb_allocator_t *> (&Null (hb_allocator_t));
+}
+
+/**
+ * hb_allocator_reference: (skip)
+ * @allocator: An allocator
+ *
+ * Increases the reference count on an allocator.
+ *
+ * Return value: (transfer full): The allocator
+ *
+ * Since: REPLACEME
+ **/
+hb_allocator_t *
+hb_allocator_reference (hb_allocator_t *allocator)
+{
+  return hb_object_reference (allocator);
+}
+
+/**
+ * hb_allocator_destroy: (skip)
+ * @allocator: An allocator
+ *
+ * Decreases the reference count on an allocator. When
+ * the reference count reaches zero, the allocator is
+ * destroyed, and its destroy callback is called.
+ *
+ * Buffers using an allocator hold a reference to it, so it stays
+ * alive until all memory obtained through it has been freed.
+ *
+ * Since: REPLACEME
+ **/
+void
+hb_allocator_destroy (hb_allocator_t *allocator)
+{
+  if (!hb_object_destroy (allocator)) return;
+
+  if (allocator->destroy)
+    allocator->destroy (allocator->user_data);
+
+  hb_free (allocator);
+}
+
+/**
+ * hb_allocator_set_user_data: (skip)
+ * @allocator: An allocator
+ * @key: The user-data key to set
+ * @data: A pointer to the user data to set
+ * @destroy: (nullable): A callback to call when @data is not needed anymore
+ * @replace: Whether to replace an existing data with the same key
+ *
+ * Attaches a user-data key/data pair to the specified allocator.
+ *
+ * Return value: `true` if success, `false` otherwise
+ *
+ * Since: REPLACEME
+ **/
+hb_bool_t
+hb_allocator_set_user_data (hb_allocator_t     *allocator,
+			    hb_user_data_key_t *key,
+			    void *              data,
+			    hb_destroy_func_t   destroy,
+			    hb_bool_t           replace)
+{
+  return hb_object_set_user_data (allocator, key, data, destroy, replace);
+}
+
+/**
+ * hb_allocator_get_user_data: (skip)
+ * @allocator: An allocator
+ * @key: The user-data key to query
+ *
+ * Fetches the user data associated with the specified key,
+ * attached to the specified allocator.
+ *
+ * Return value: (transfer none): A pointer to the user data
+ *
+ * Since: REPLACEME
+ **/
+void *
+hb_allocator_get_user_data (const hb_allocator_t *allocator,
+			    hb_user_data_key_t   *key)
+{
+  return hb_object_get_user_data (allocator, key);
+}
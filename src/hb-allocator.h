@@ -0,0 +1,103 @@
+/*
+ * Copyright © 2023  The HarfBuzz Authors
+ *
+ *  This is part of HarfBuzz, a text shaping library.
+ *
+ * Permission is hereby granted, without written agreement and without
+ * license or royalty fees, to use, copy, modify, and distribute this
+ * software and its documentation for any purpose, provided that the
+ * above copyright notice and the following two paragraphs appear in
+ * all copies of this software.
+ *
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES
+ * ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN
+ * IF THE COPYRIGHT HOLDER HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+ * DAMAGE.
+ *
+ * THE COPYRIGHT HOLDER SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE COPYRIGHT HOLDER HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ */
+
+#if !defined(HB_H_IN) && !defined(HB_NO_SINGLE_HEADER_ERROR)
+#error "Include <hb.h> instead."
+#endif
+
+#ifndef HB_ALLOCATOR_H
+#define HB_ALLOCATOR_H
+
+#include "hb-common.h"
+
+HB_BEGIN_DECLS
+
+
+/**
+ * hb_allocator_t:
+ *
+ * Data type for holding a custom memory allocator.  Currently only
+ * #hb_buffer_t accepts one, for its glyph info and position arrays; see
+ * hb_buffer_set_allocator().
+ *
+ * Since: REPLACEME
+ **/
+typedef struct hb_allocator_t hb_allocator_t;
+
+/**
+ * hb_allocator_func_t:
+ * @ptr: (nullable): The block to resize or free, or `NULL` to allocate a new one
+ * @old_size: The number of bytes at the start of @ptr that are in use and
+ * must be preserved; zero if @ptr is `NULL`
+ * @new_size: The size to allocate or resize to, in bytes, or zero to free @ptr
+ * @user_data: User data pointer passed to hb_allocator_create()
+ *
+ * A virtual method for #hb_allocator_t, with the semantics of realloc():
+ * it allocates, resizes and frees blocks.  Blocks must be suitably aligned
+ * for any type, as with malloc().
+ *
+ * Since the size of every block is passed back, a request-scoped arena can
+ * implement this by handing out memory on allocation, copying @old_size bytes
+ * on resize, and doing nothing on free, then releasing everything at once
+ * when the request is done.
+ *
+ * Return value: The new block, or `NULL` on failure or when @new_size is zero.
+ * On failure, @ptr must be left untouched.
+ *
+ * Since: REPLACEME
+ **/
+typedef void * (*hb_allocator_func_t) (void         *ptr,
+				       unsigned int  old_size,
+				       unsigned int  new_size,
+				       void         *user_data);
+
+HB_EXTERN hb_allocator_t *
+hb_allocator_create (hb_allocator_func_t  func,
+		     void                *user_data,
+		     hb_destroy_func_t    destroy);
+
+HB_EXTERN hb_allocator_t *
+hb_allocator_get_empty (void);
+
+HB_EXTERN hb_allocator_t *
+hb_allocator_reference (hb_allocator_t *allocator);
+
+HB_EXTERN void
+hb_allocator_destroy (hb_allocator_t *allocator);
+
+HB_EXTERN hb_bool_t
+hb_allocator_set_user_data (hb_allocator_t     *allocator,
+			    hb_user_data_key_t *key,
+			    void *              data,
+			    hb_destroy_func_t   destroy,
+			    hb_bool_t           replace);
+
+HB_EXTERN void *
+hb_allocator_get_user_data (const hb_allocator_t *allocator,
+			    hb_user_data_key_t   *key);
+
+
+HB_END_DECLS
+
+#endif /* HB_ALLOCATOR_H */
@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2023  The HarfBuzz Authors
+ *
+ *  This is part of HarfBuzz, a text shaping library.
+ *
+ * Permission is hereby granted, without written agreement and without
+ * license or royalty fees, to use, copy, modify, and distribute this
+ * software and its documentation for any purpose, provided that the
+ * above copyright notice and the following two paragraphs appear in
+ * all copies of this software.
+ *
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES
+ * ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN
+ * IF THE COPYRIGHT HOLDER HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+ * DAMAGE.
+ *
+ * THE COPYRIGHT HOLDER SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE COPYRIGHT HOLDER HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ */
+
+#ifndef HB_ALLOCATOR_HH
+#define HB_ALLOCATOR_HH
+
+#include "hb.hh"
+
+
+struct hb_allocator_t
+{
+  hb_object_header_t header;
+
+  hb_allocator_func_t func;
+  void *user_data;
+  hb_destroy_func_t destroy;
+
+  /* Like realloc(), but told how much of ptr to keep.  Without a func
+   * (as in the empty allocator) defers to the library-wide allocator. */
+  void *resize (void *ptr, unsigned int old_size, unsigned int new_size)
+  {
+    if (func)
+      return func (ptr, old_size, new_size, user_data);
+
+    if (!new_size)
+    {
+      hb_free (ptr);
+      return nullptr;
+    }
+    return hb_realloc (ptr, new_size);
+  }
+
+  void release (void *ptr, unsigned int size)
+  {
+    if (ptr)
+      resize (ptr, size, 0);
+  }
+};
+
+
+#endif /* HB_ALLOCATOR_HH */
@@ -33,6 +33,17 @@
 
 /* Compiler-assisted vectorization. */
 
+/* When the compiler supports generic vector types, process the bitset in
+ * register-sized chunks; these lower to AVX2, SSE2 or NEON instructions
+ * depending on the target.  Otherwise fall back to scalar loops. */
+#if defined(__GNUC__) && !defined(HB_NO_BIT_PAGE_SIMD)
+#if defined(__AVX2__)
+#define HB_BIT_PAGE_SIMD_BYTES 32
+#elif defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define HB_BIT_PAGE_SIMD_BYTES 16
+#endif
+#endif
+
 /* Type behaving similar to vectorized vars defined using __attribute__((vector_size(...))),
  * basically a fixed-size bitset. We can't use the compiler type because hb_vector_t cannot
  * guarantee alignment requirements. */
@@ -57,6 +68,14 @@ struct hb_vector_size_t
   hb_vector_size_t process (const Op& op) const
   {
     hb_vector_size_t r;
+#ifdef HB_BIT_PAGE_SIMD_BYTES
+    if (simd_capable)
+    {
+      for (unsigned int i = 0; i < ARRAY_LENGTH (v); i += SIMD_LEN)
+	simd_store (&r.v[i], op (simd_load (&v[i])));
+      return r;
+    }
+#endif
     for (unsigned int i = 0; i < ARRAY_LENGTH (v); i++)
       r.v[i] = op (v[i]);
     return r;
@@ -65,10 +84,42 @@ struct hb_vector_size_t
   hb_vector_size_t process (const Op& op, const hb_vector_size_t &o) const
   {
     hb_vector_size_t r;
+#ifdef HB_BIT_PAGE_SIMD_BYTES
+    if (simd_capable)
+    {
+      for (unsigned int i = 0; i < ARRAY_LENGTH (v); i += SIMD_LEN)
+	simd_store (&r.v[i], op (simd_load (&v[i]), simd_load (&o.v[i])));
+      return r;
+    }
+#endif
     for (unsigned int i = 0; i < ARRAY_LENGTH (v); i++)
       r.v[i] = op (v[i], o.v[i]);
     return r;
   }
+
+  /* Returns whether op (*this, o) has no bits set, without materializing it. */
+  template <typename Op>
+  bool process_is_zero (const Op& op, const hb_vector_size_t &o) const
+  {
+#ifdef HB_BIT_PAGE_SIMD_BYTES
+    if (simd_capable)
+    {
+      simd_t acc = simd_t {};
+      for (unsigned int i = 0; i < ARRAY_LENGTH (v); i += SIMD_LEN)
+	acc |= op (simd_load (&v[i]), simd_load (&o.v[i]));
+      elt_t r = 0;
+      for (unsigned int i = 0; i < SIMD_LEN; i++)
+	r |= acc[i];
+      return !r;
+    }
+#endif
+    elt_t r = 0;
+    for (unsigned int i = 0; i < ARRAY_LENGTH (v); i++)
+      r |= op (v[i], o.v[i]);
+    return !r;
+  }
+  bool is_zero () const
+  { return process_is_zero (hb_bitwise_or, *this); }
   hb_vector_size_t operator | (const hb_vector_size_t &o) const
   { return process (hb_bitwise_or, o); }
   hb_vector_size_t operator & (const hb_vector_size_t &o) const
@@ -82,6 +133,17 @@ struct hb_vector_size_t
   { return hb_array (v); }
 
   private:
+#ifdef HB_BIT_PAGE_SIMD_BYTES
+  typedef elt_t simd_t __attribute__ ((vector_size (HB_BIT_PAGE_SIMD_BYTES)));
+  static constexpr unsigned SIMD_LEN = HB_BIT_PAGE_SIMD_BYTES / sizeof (elt_t);
+  static constexpr bool simd_capable = std::is_integral<elt_t>::value &&
+				       0 == byte_size % HB_BIT_PAGE_SIMD_BYTES;
+
+  /* Storage is not guaranteed to be vector-aligned; memcpy compiles to unaligned loads / stores. */
+  static simd_t simd_load (const elt_t *p) { simd_t r; hb_memcpy (&r, p, sizeof (r)); return r; }
+  static void simd_store (elt_t *p, const simd_t &x) { hb_memcpy (p, &x, sizeof (x)); }
+#endif
+
   static_assert (0 == byte_size % sizeof (elt_t), "");
   elt_t v[byte_size / sizeof (elt_t)];
 };
@@ -95,13 +157,7 @@ struct hb_bit_page_t
   static inline constexpr unsigned len ()
   { return ARRAY_LENGTH_CONST (v); }
 
-  bool is_empty () const
-  {
-    return
-    + hb_iter (v)
-    | hb_none
-    ;
-  }
+  bool is_empty () const { return v.is_zero (); }
   uint32_t hash () const
   {
     return
@@ -217,19 +273,9 @@ struct hb_bit_page_t
   }
 
   bool is_equal (const hb_bit_page_t &other) const
-  {
-    for (unsigned i = 0; i < len (); i++)
-      if (v[i] != other.v[i])
-	return false;
-    return true;
-  }
+  { return v.process_is_zero (hb_bitwise_xor, other.v); }
   bool is_subset (const hb_bit_page_t &larger_page) const
-  {
-    for (unsigned i = 0; i < len (); i++)
-      if (~larger_page.v[i] & v[i])
-	return false;
-    return true;
-  }
+  { return v.process_is_zero (hb_bitwise_gt, larger_page.v); }
 
   unsigned int get_population () const
   {
@@ -292,6 +338,39 @@ struct hb_bit_page_t
     *codepoint = INVALID;
     return false;
   }
+  // Returns the first page-relative value at or after start that is NOT in
+  // this page, or PAGE_BITS if every value from start to the end of the page is.
+  unsigned int next_unset (unsigned int start) const
+  {
+    unsigned int i = start / ELT_BITS;
+    elt_t vv = ~v[i] & ~((elt_t (1) << (start & ELT_MASK)) - 1);
+    while (!vv)
+    {
+      if (++i == len ()) return PAGE_BITS;
+      vv = ~v[i];
+    }
+    return i * ELT_BITS + elt_get_min (vv);
+  }
+  // Returns the last page-relative value at or before start that is NOT in
+  // this page, or -1 if every value from the start of the page to start is.
+  int previous_unset (unsigned int start) const
+  {
+    unsigned int i = start / ELT_BITS;
+    unsigned int j = start & ELT_MASK;
+
+    /* Fancy mask to avoid shifting by elt_t bitsize, which is undefined. */
+    const elt_t mask = j < 8 * sizeof (elt_t) - 1 ?
+		       ((elt_t (1) << (j + 1)) - 1) :
+		       (elt_t) -1;
+    elt_t vv = ~v[i] & mask;
+    while (!vv)
+    {
+      if (!i) return -1;
+      vv = ~v[--i];
+    }
+    return i * ELT_BITS + elt_get_max (vv);
+  }
+
   hb_codepoint_t get_min () const
   {
     for (unsigned int i = 0; i < len (); i++)
@@ -304,7 +383,7 @@ struct hb_bit_page_t
     for (int i = len () - 1; i >= 0; i--)
       if (v[i])
 	return i * ELT_BITS + elt_get_max (v[i]);
-    return 0;
+    return INVALID;
   }
 
   static constexpr hb_codepoint_t INVALID = HB_SET_VALUE_INVALID;
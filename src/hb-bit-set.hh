@@ -694,10 +694,30 @@ struct hb_bit_set_t
       return false;
     }
 
-    /* TODO Speed up. */
-    *last = *first = i;
-    while (next (&i) && i == *last + 1)
-      (*last)++;
+    *first = i;
+
+    /* Extend the run a word at a time; pages full past the run start are
+     * skipped whole.  The run ends at the first unset value or page gap. */
+    unsigned int pi = last_page_lookup;
+    if (unlikely (pi >= page_map.length || page_map.arrayZ[pi].major != get_major (i)))
+      page_map.bfind (get_major (i), &pi);
+    unsigned int start = page_remainder (i);
+    for (; pi < page_map.length; pi++)
+    {
+      const page_map_t &map = page_map.arrayZ[pi];
+      if (map.major != get_major (i))
+	break;
+
+      unsigned int end = pages.arrayZ[map.index].next_unset (start);
+      if (end < page_t::PAGE_BITS)
+      {
+	*last = major_start (map.major) + end - 1;
+	return true;
+      }
+      *last = major_start (map.major) + page_t::PAGE_BITMASK;
+      i = *last + 1;
+      start = 0;
+    }
 
     return true;
   }
@@ -712,10 +732,28 @@ struct hb_bit_set_t
       return false;
     }
 
-    /* TODO Speed up. */
-    *last = *first = i;
-    while (previous (&i) && i == *first - 1)
-      (*first)--;
+    *last = i;
+
+    /* Extend the run backwards a word at a time, skipping full pages. */
+    unsigned int pi = last_page_lookup;
+    if (unlikely (pi >= page_map.length || page_map.arrayZ[pi].major != get_major (i)))
+      page_map.bfind (get_major (i), &pi);
+    unsigned int start = page_remainder (i);
+    while (true)
+    {
+      const page_map_t &map = page_map.arrayZ[pi];
+      int end = pages.arrayZ[map.index].previous_unset (start);
+      if (end >= 0)
+      {
+	*first = major_start (map.major) + end + 1;
+	return true;
+      }
+      *first = major_start (map.major);
+      if (!pi || page_map.arrayZ[pi - 1].major + 1 != map.major)
+	break;
+      pi--;
+      start = page_t::PAGE_BITMASK;
+    }
 
     return true;
   }
@@ -182,8 +182,8 @@ hb_buffer_t::enlarge (unsigned int size)
     goto done;
 
   static_assert (sizeof (info[0]) == sizeof (pos[0]), "");
-  new_pos = (hb_glyph_position_t *) hb_realloc (pos, new_bytes);
-  new_info = (hb_glyph_info_t *) hb_realloc (info, new_bytes);
+  new_pos = (hb_glyph_position_t *) allocator->resize (pos, allocated * sizeof (pos[0]), new_bytes);
+  new_info = (hb_glyph_info_t *) allocator->resize (info, allocated * sizeof (info[0]), new_bytes);
 
 done:
   if (unlikely (!new_pos || !new_info))
@@ -266,6 +266,7 @@ hb_buffer_t::similar (const hb_buffer_t &src)
 {
   hb_unicode_funcs_destroy (unicode);
   unicode = hb_unicode_funcs_reference (src.unicode);
+  set_allocator (hb_buffer_get_allocator (&src));
   flags = src.flags;
   cluster_level = src.cluster_level;
   replacement = src.replacement;
@@ -273,6 +274,22 @@ hb_buffer_t::similar (const hb_buffer_t &src)
   not_found = src.not_found;
 }
 
+void
+hb_buffer_t::set_allocator (hb_allocator_t *allocator_)
+{
+  /* Storage has to go back to the allocator it came from. */
+  clear ();
+  allocator->release (info, allocated * sizeof (info[0]));
+  allocator->release (pos, allocated * sizeof (pos[0]));
+  info = out_info = nullptr;
+  pos = nullptr;
+  allocated = 0;
+
+  hb_allocator_reference (allocator_);
+  hb_allocator_destroy (allocator);
+  allocator = allocator_;
+}
+
 void
 hb_buffer_t::reset ()
 {
@@ -699,6 +716,7 @@ DEFINE_NULL_INSTANCE (hb_buffer_t) =
   HB_OBJECT_HEADER_STATIC,
 
   const_cast<hb_unicode_funcs_t *> (&_hb_Null_hb_unicode_funcs_t),
+  nullptr, /* allocator */
   HB_BUFFER_FLAG_DEFAULT,
   HB_BUFFER_CLUSTER_LEVEL_DEFAULT,
   HB_BUFFER_REPLACEMENT_CODEPOINT_DEFAULT,
@@ -740,6 +758,7 @@ hb_buffer_create ()
   if (!(buffer = hb_object_create<hb_buffer_t> ()))
     return hb_buffer_get_empty ();
 
+  buffer->allocator = hb_allocator_get_empty ();
   buffer->max_len = HB_BUFFER_MAX_LEN_DEFAULT;
   buffer->max_ops = HB_BUFFER_MAX_OPS_DEFAULT;
 
@@ -838,8 +857,9 @@ hb_buffer_destroy (hb_buffer_t *buffer)
 
   hb_unicode_funcs_destroy (buffer->unicode);
 
-  hb_free (buffer->info);
-  hb_free (buffer->pos);
+  buffer->allocator->release (buffer->info, buffer->allocated * sizeof (buffer->info[0]));
+  buffer->allocator->release (buffer->pos, buffer->allocated * sizeof (buffer->pos[0]));
+  hb_allocator_destroy (buffer->allocator);
 #ifndef HB_NO_BUFFER_MESSAGE
   if (buffer->message_destroy)
     buffer->message_destroy (buffer->message_data);
@@ -1359,6 +1379,55 @@ hb_buffer_get_not_found_glyph (const hb_buffer_t *buffer)
   return buffer->not_found;
 }
 
+/**
+ * hb_buffer_set_allocator:
+ * @buffer: An #hb_buffer_t
+ * @allocator: (nullable): The allocator to use, or `NULL` for the
+ * library-wide allocator
+ *
+ * Sets the allocator @buffer gets the storage for its glyph info and
+ * position arrays from.  The buffer holds a reference to @allocator
+ * until it is destroyed or another allocator is set.
+ *
+ * Since storage must be returned to the allocator it came from, this
+ * releases the current storage of @buffer and clears its contents, as
+ * with hb_buffer_clear_contents().  The allocator is kept across
+ * hb_buffer_reset(), and is copied by hb_buffer_create_similar().
+ *
+ * Since: REPLACEME
+ **/
+void
+hb_buffer_set_allocator (hb_buffer_t    *buffer,
+			 hb_allocator_t *allocator)
+{
+  if (unlikely (hb_object_is_immutable (buffer)))
+    return;
+
+  if (!allocator)
+    allocator = hb_allocator_get_empty ();
+
+  buffer->set_allocator (allocator);
+}
+
+/**
+ * hb_buffer_get_allocator:
+ * @buffer: An #hb_buffer_t
+ *
+ * Fetches the allocator of @buffer.
+ *
+ * Return value: (transfer none):
+ * The allocator set with hb_buffer_set_allocator(), or the empty allocator.
+ *
+ * Since: REPLACEME
+ **/
+hb_allocator_t *
+hb_buffer_get_allocator (const hb_buffer_t *buffer)
+{
+  if (unlikely (!buffer->allocator))
+    return hb_allocator_get_empty ();
+  return buffer->allocator;
+}
+
 
 /**
  * hb_buffer_clear_contents:
@@ -1729,10 +1798,45 @@ hb_buffer_add_utf (hb_buffer_t  *buffer,
   const T *end = next + item_length;
   while (next < end)
   {
-    hb_codepoint_t u;
-    const T *old_next = next;
-    next = utf_t::next (next, end, &u, replacement);
-    buffer->add (u, old_next - (const T *) text);
+    /* Decode straight into the info array.  No codepoint is shorter than
+     * one code unit, so room for a chunk's worth of code units is enough;
+     * going in chunks keeps multi-unit text from allocating much more
+     * than it needs. */
+    const T *chunk_end = end - next > 4096 ? next + 4096 : end;
+    if (unlikely (!buffer->ensure (buffer->len + (chunk_end - next))))
+    {
+      next = end;
+      break;
+    }
+
+    hb_glyph_info_t *info = buffer->info + buffer->len;
+    auto emit = [&] (hb_codepoint_t u, const T *p)
+    {
+      info->codepoint = u;
+      info->mask = 0;
+      info->cluster = p - text;
+      info->var1.u32 = 0;
+      info->var2.u32 = 0;
+      info++;
+    };
+
+    while (next < chunk_end)
+    {
+      /* Runs that need no decoding, eg. ASCII in UTF-8, are copied over
+       * in a tight loop; anything else goes through the validating
+       * decoder one codepoint at a time. */
+      for (const T *run_end = utf_t::skip_trivial (next, chunk_end); next < run_end; next++)
+	emit (*next, next);
+      if (next == chunk_end)
+	break;
+
+      hb_codepoint_t u;
+      const T *old_next = next;
+      next = utf_t::next (next, end, &u, replacement);
+      emit (u, old_next);
+    }
+
+    buffer->len = info - buffer->info;
   }
 
   /* Add post-context */
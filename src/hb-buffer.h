@@ -34,6 +34,7 @@
 #ifndef HB_BUFFER_H
 #define HB_BUFFER_H
 
+#include "hb-allocator.h"
 #include "hb-common.h"
 #include "hb-unicode.h"
 #include "hb-font.h"
@@ -487,6 +488,13 @@ hb_buffer_set_not_found_glyph (hb_buffer_t    *buffer,
 HB_EXTERN hb_codepoint_t
 hb_buffer_get_not_found_glyph (const hb_buffer_t *buffer);
 
+HB_EXTERN void
+hb_buffer_set_allocator (hb_buffer_t    *buffer,
+			 hb_allocator_t *allocator);
+
+HB_EXTERN hb_allocator_t *
+hb_buffer_get_allocator (const hb_buffer_t *buffer);
+
 
 /*
  * Content API.
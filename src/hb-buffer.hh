@@ -31,6 +31,7 @@
 #define HB_BUFFER_HH
 
 #include "hb.hh"
+#include "hb-allocator.hh"
 #include "hb-unicode.hh"
 #include "hb-set-digest.hh"
 
@@ -52,6 +53,7 @@ enum hb_buffer_scratch_flags_t {
   HB_BUFFER_SCRATCH_FLAG_HAS_CGJ			= 0x00000010u,
   HB_BUFFER_SCRATCH_FLAG_HAS_GLYPH_FLAGS		= 0x00000020u,
   HB_BUFFER_SCRATCH_FLAG_HAS_BROKEN_SYLLABLE		= 0x00000040u,
+  HB_BUFFER_SCRATCH_FLAG_HAS_UNICODE_MARKS		= 0x00000080u,
 
   /* Reserved for shapers' internal use. */
   HB_BUFFER_SCRATCH_FLAG_SHAPER0			= 0x01000000u,
@@ -75,6 +77,7 @@ struct hb_buffer_t
    */
 
   hb_unicode_funcs_t *unicode; /* Unicode functions */
+  hb_allocator_t *allocator; /* For info / pos arrays */
   hb_buffer_flags_t flags; /* BOT / EOT / etc. */
   hb_buffer_cluster_level_t cluster_level;
   hb_codepoint_t replacement; /* U+FFFD or something else. */
@@ -197,6 +200,7 @@ struct hb_buffer_t
   }
 
   HB_INTERNAL void similar (const hb_buffer_t &src);
+  HB_INTERNAL void set_allocator (hb_allocator_t *allocator_);
   HB_INTERNAL void reset ();
   HB_INTERNAL void clear ();
 
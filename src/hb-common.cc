@@ -227,11 +227,10 @@ lang_equal (hb_language_t  v1,
   return *p1 == canon_map[*p2];
 }
 
-#if 0
 static unsigned int
 lang_hash (const void *key)
 {
-  const unsigned char *p = key;
+  const unsigned char *p = (const unsigned char *) key;
   unsigned int h = 0;
   while (canon_map[*p])
     {
@@ -241,7 +240,6 @@ lang_hash (const void *key)
 
   return h;
 }
-#endif
 
 
 struct hb_language_item_t {
@@ -271,31 +269,37 @@ struct hb_language_item_t {
 };
 
 
-/* Thread-safe lockfree language list */
+/* Thread-safe lockfree language hash; each bucket is a lockfree list. */
 
-static hb_atomic_ptr_t <hb_language_item_t> langs;
+static hb_atomic_ptr_t <hb_language_item_t> langs[256];
+static hb_atomic_int_t langs_count;
 
 static inline void
 free_langs ()
 {
-retry:
-  hb_language_item_t *first_lang = langs;
-  if (unlikely (!langs.cmpexch (first_lang, nullptr)))
-    goto retry;
-
-  while (first_lang) {
-    hb_language_item_t *next = first_lang->next;
-    first_lang->fini ();
-    hb_free (first_lang);
-    first_lang = next;
+  for (auto &bucket : langs)
+  {
+  retry:
+    hb_language_item_t *first_lang = bucket;
+    if (unlikely (!bucket.cmpexch (first_lang, nullptr)))
+      goto retry;
+
+    while (first_lang) {
+      hb_language_item_t *next = first_lang->next;
+      first_lang->fini ();
+      hb_free (first_lang);
+      first_lang = next;
+    }
   }
 }
 
 static hb_language_item_t *
 lang_find_or_insert (const char *key)
 {
+  hb_atomic_ptr_t <hb_language_item_t> &bucket = langs[lang_hash (key) % ARRAY_LENGTH (langs)];
+
 retry:
-  hb_language_item_t *first_lang = langs;
+  hb_language_item_t *first_lang = bucket;
 
   for (hb_language_item_t *lang = first_lang; lang; lang = lang->next)
     if (*lang == key)
@@ -313,14 +317,14 @@ retry:
     return nullptr;
   }
 
-  if (unlikely (!langs.cmpexch (first_lang, lang)))
+  if (unlikely (!bucket.cmpexch (first_lang, lang)))
   {
     lang->fini ();
     hb_free (lang);
     goto retry;
   }
 
-  if (!first_lang)
+  if (!langs_count.inc ())
     hb_atexit (free_langs); /* First person registers atexit() callback. */
 
   return lang;
@@ -365,6 +365,10 @@ struct hb_no_trace_t {
 #define HB_DEBUG_CORETEXT (HB_DEBUG+0)
 #endif
 
+#ifndef HB_DEBUG_DIGEST
+#define HB_DEBUG_DIGEST (HB_DEBUG+0)
+#endif
+
 #ifndef HB_DEBUG_DIRECTWRITE
 #define HB_DEBUG_DIRECTWRITE (HB_DEBUG+0)
 #endif
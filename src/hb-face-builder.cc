@@ -91,57 +91,175 @@ _hb_face_builder_data_destroy (void *user_data)
   hb_free (data);
 }
 
-static hb_blob_t *
-_hb_face_builder_data_reference_blob (hb_face_builder_data_t *data)
+static hb_tag_t
+_hb_face_builder_data_sfnt_tag (hb_face_builder_data_t *data)
 {
-
-  unsigned int table_count = data->tables.get_population ();
-  unsigned int face_length = table_count * 16 + 12;
-
-  for (auto info : data->tables.values())
-    face_length += hb_ceil_to_4 (hb_blob_get_length (info.data));
-
-  char *buf = (char *) hb_malloc (face_length);
-  if (unlikely (!buf))
-    return nullptr;
-
-  hb_serialize_context_t c (buf, face_length);
-  c.propagate_error (data->tables);
-  OT::OpenTypeFontFile *f = c.start_serialize<OT::OpenTypeFontFile> ();
-
   bool is_cff = (data->tables.has (HB_TAG ('C','F','F',' '))
                  || data->tables.has (HB_TAG ('C','F','F','2')));
-  hb_tag_t sfnt_tag = is_cff ? OT::OpenTypeFontFile::CFFTag : OT::OpenTypeFontFile::TrueTypeTag;
+  return is_cff ? OT::OpenTypeFontFile::CFFTag : OT::OpenTypeFontFile::TrueTypeTag;
+}
 
+static bool
+_hb_face_builder_data_sort_entries (hb_face_builder_data_t *data,
+				    hb_vector_t<hb_pair_t <hb_tag_t, face_table_info_t>> &sorted_entries)
+{
   // Sort the tags so that produced face is deterministic.
-  hb_vector_t<hb_pair_t <hb_tag_t, face_table_info_t>> sorted_entries;
   data->tables.iter () | hb_sink (sorted_entries);
   if (unlikely (sorted_entries.in_error ()))
+    return false;
+
+  sorted_entries.qsort (compare_entries);
+  return true;
+}
+
+static bool
+_hb_face_builder_push_piece (hb_vector_t<hb_blob_t *> &pieces,
+			     hb_blob_t *blob)
+{
+  if (unlikely (blob == hb_blob_get_empty ()))
+    return false;
+  pieces.push (blob);
+  if (unlikely (pieces.in_error ()))
   {
-    hb_free (buf);
-    return nullptr;
+    hb_blob_destroy (blob);
+    return false;
   }
+  return true;
+}
 
-  sorted_entries.qsort (compare_entries);
+/* Collects the font file that @data compiles to as a list of blobs, to
+ * be written out one after the other: the table directory, then each
+ * table, padded to four bytes.  Only the directory is allocated; the
+ * tables are referenced as added, the head table in pieces around its
+ * checkSumAdjustment.  Table checksums are taken here rather than when
+ * the tables are added, as writable blobs may have changed since.  On
+ * failure, @pieces still has to be destroyed. */
+static bool
+_hb_face_builder_data_reference_pieces (hb_face_builder_data_t *data,
+					hb_vector_t<hb_blob_t *> &pieces)
+{
+  hb_vector_t<hb_pair_t <hb_tag_t, face_table_info_t>> sorted_entries;
+  if (unlikely (data->tables.in_error () ||
+		!_hb_face_builder_data_sort_entries (data, sorted_entries)))
+    return false;
 
-  bool ret = f->serialize_single (&c,
-                                  sfnt_tag,
-                                  + sorted_entries.iter()
-                                  | hb_map ([&] (hb_pair_t<hb_tag_t, face_table_info_t> _) {
-                                    return hb_pair_t<hb_tag_t, hb_blob_t*> (_.first, _.second.data);
-                                  }));
+  /* checkSumAdjustment goes right after the directory, in the same
+   * allocation. */
+  unsigned directory_length = 12 + sorted_entries.length * 16;
+  char *buf = (char *) hb_calloc (directory_length + 4, 1);
+  if (unlikely (!buf))
+    return false;
 
+  uint32_t checksum_adjustment = 0;
+  hb_serialize_context_t c (buf, directory_length);
+  OT::OpenTypeOffsetTable *f = c.start_serialize<OT::OpenTypeOffsetTable> ();
+  bool ret = f->serialize_directory (&c,
+				     _hb_face_builder_data_sfnt_tag (data),
+				     + sorted_entries.iter()
+				     | hb_map ([&] (hb_pair_t<hb_tag_t, face_table_info_t> _) {
+				       return hb_pair_t<hb_tag_t, hb_pair_t<unsigned, uint32_t>>
+					 (_.first, {_.second.data->length,
+						    OT::OpenTypeOffsetTable::table_checksum (_.first, _.second.data)});
+				     }),
+				     &checksum_adjustment);
   c.end_serialize ();
-
-  if (unlikely (!ret))
+  if (unlikely (!ret || c.in_error ()))
   {
     hb_free (buf);
+    return false;
+  }
+  * (OT::HBUINT32 *) (buf + directory_length) = checksum_adjustment;
+
+  hb_blob_t *directory = hb_blob_create (buf, directory_length + 4,
+					 HB_MEMORY_MODE_READONLY,
+					 buf, hb_free);
+  static const char zeros[4] = {};
+  hb_blob_t *padding = hb_blob_create (zeros, sizeof (zeros),
+				       HB_MEMORY_MODE_READONLY,
+				       nullptr, nullptr);
+
+  ret = _hb_face_builder_push_piece (pieces, hb_blob_create_sub_blob (directory, 0, directory_length));
+  for (const auto &entry : sorted_entries)
+  {
+    if (unlikely (!ret)) break;
+
+    hb_blob_t *table = entry.second.data;
+    unsigned length = table->length;
+    if (entry.first == HB_OT_TAG_head && length >= OT::head::static_size)
+    {
+      const unsigned adjustment_offset = 8; /* Of checkSumAdjustment. */
+      ret = _hb_face_builder_push_piece (pieces, hb_blob_create_sub_blob (table, 0, adjustment_offset)) &&
+	    _hb_face_builder_push_piece (pieces, hb_blob_create_sub_blob (directory, directory_length, 4)) &&
+	    _hb_face_builder_push_piece (pieces, hb_blob_create_sub_blob (table, adjustment_offset + 4, (unsigned) -1));
+    }
+    else if (length)
+      ret = _hb_face_builder_push_piece (pieces, hb_blob_reference (table));
+
+    if (ret && length % 4)
+      ret = _hb_face_builder_push_piece (pieces, hb_blob_create_sub_blob (padding, 0, 4 - length % 4));
+  }
+
+  hb_blob_destroy (padding);
+  hb_blob_destroy (directory);
+  return ret;
+}
+
+static void
+_hb_face_builder_destroy_pieces (hb_vector_t<hb_blob_t *> &pieces)
+{
+  for (hb_blob_t *piece : pieces)
+    hb_blob_destroy (piece);
+  pieces.fini ();
+}
+
+static hb_blob_t *
+_hb_face_builder_data_reference_blob (hb_face_builder_data_t *data)
+{
+  hb_vector_t<hb_blob_t *> pieces;
+  if (unlikely (!_hb_face_builder_data_reference_pieces (data, pieces)))
+  {
+    _hb_face_builder_destroy_pieces (pieces);
+    return nullptr;
+  }
+
+  unsigned face_length = 0;
+  for (hb_blob_t *piece : pieces)
+    face_length += piece->length;
+
+  char *buf = (char *) hb_malloc (face_length);
+  if (unlikely (!buf))
+  {
+    _hb_face_builder_destroy_pieces (pieces);
     return nullptr;
   }
 
+  char *p = buf;
+  for (hb_blob_t *piece : pieces)
+  {
+    hb_memcpy (p, piece->data, piece->length);
+    p += piece->length;
+  }
+  _hb_face_builder_destroy_pieces (pieces);
+
   return hb_blob_create (buf, face_length, HB_MEMORY_MODE_WRITABLE, buf, hb_free);
 }
 
+static bool
+_hb_face_builder_data_write (hb_face_builder_data_t *data,
+			     hb_face_t *face,
+			     hb_face_builder_write_func_t func,
+			     void *user_data)
+{
+  hb_vector_t<hb_blob_t *> pieces;
+  bool ret = _hb_face_builder_data_reference_pieces (data, pieces);
+  for (hb_blob_t *piece : pieces)
+    if (ret && !func (face, piece->data, piece->length, user_data))
+      ret = false;
+
+  _hb_face_builder_destroy_pieces (pieces);
+  return ret;
+}
+
 static hb_blob_t *
 _hb_face_builder_reference_table (hb_face_t *face HB_UNUSED, hb_tag_t tag, void *user_data)
 {
@@ -209,6 +327,88 @@ hb_face_builder_add_table (hb_face_t *face, hb_tag_t tag, hb_blob_t *blob)
   return true;
 }
 
+/**
+ * hb_face_builder_write:
+ * @face: A face object created with hb_face_builder_create()
+ * @func: (scope call): The function to write the font file with
+ * @user_data: Data to pass to @func
+ *
+ * Writes out the font file that hb_face_reference_blob() compiles @face
+ * to, piece by piece, without assembling it in memory: the table
+ * directory is passed to @func first, followed by the table blobs as
+ * added.  The faces returned by hb_subset_or_fail() can be written out
+ * this way too.
+ *
+ * Return value: `true` if the whole font file was written, `false` if
+ * @face was not created with hb_face_builder_create(), on allocation
+ * failure, or if @func returned `false`.
+ *
+ * Since: REPLACEME
+ **/
+hb_bool_t
+hb_face_builder_write (hb_face_t                    *face,
+		       hb_face_builder_write_func_t  func,
+		       void                         *user_data)
+{
+  if (unlikely (face->destroy != (hb_destroy_func_t) _hb_face_builder_data_destroy))
+    return false;
+
+  hb_face_builder_data_t *data = (hb_face_builder_data_t *) face->user_data;
+  return _hb_face_builder_data_write (data, face, func, user_data);
+}
+
+/**
+ * hb_face_builder_reference_blobs:
+ * @face: A face object created with hb_face_builder_create()
+ * @start_offset: The index of first blob to retrieve
+ * @blob_count: (inout): Input = the maximum number of blobs to return;
+ *                Output = the actual number of blobs returned (may be zero)
+ * @blobs: (out) (array length=blob_count) (transfer full): The array of blobs
+ *
+ * Fetches the font file that hb_face_reference_blob() compiles @face to
+ * as a list of blobs, to be written out one after the other, for
+ * example with writev(). The list returned will begin at the offset
+ * provided.
+ *
+ * Only the table directory is allocated; the table blobs are referenced
+ * as added, and the directory is made from their contents at the time
+ * of the call.  Each of the returned blobs must be released with
+ * hb_blob_destroy().
+ *
+ * Return value: Total number of blobs, or zero if @face was not created
+ * with hb_face_builder_create() or on allocation failure
+ *
+ * Since: REPLACEME
+ **/
+unsigned int
+hb_face_builder_reference_blobs (hb_face_t    *face,
+				 unsigned int  start_offset,
+				 unsigned int *blob_count, /* IN/OUT */
+				 hb_blob_t   **blobs /* OUT */)
+{
+  hb_vector_t<hb_blob_t *> pieces;
+  if (unlikely (face->destroy != (hb_destroy_func_t) _hb_face_builder_data_destroy ||
+		!_hb_face_builder_data_reference_pieces ((hb_face_builder_data_t *) face->user_data,
+							 pieces)))
+  {
+    _hb_face_builder_destroy_pieces (pieces);
+    if (blob_count)
+      *blob_count = 0;
+    return 0;
+  }
+
+  if (blob_count)
+  {
+    + pieces.as_array ().sub_array (start_offset, blob_count)
+    | hb_apply ([&] (hb_blob_t *&piece) { *blobs++ = piece; piece = nullptr; })
+    ;
+  }
+
+  unsigned total = pieces.length;
+  _hb_face_builder_destroy_pieces (pieces);
+  return total;
+}
+
 /**
  * hb_face_builder_sort_tables:
  * @face: A face object created with hb_face_builder_create()
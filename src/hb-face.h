@@ -181,6 +181,36 @@ HB_EXTERN void
 hb_face_builder_sort_tables (hb_face_t *face,
                              const hb_tag_t  *tags);
 
+/**
+ * hb_face_builder_write_func_t:
+ * @face: The face being written
+ * @data: (array length=length): The next piece of the font file
+ * @length: The length of @data
+ * @user_data: User data pointer passed to hb_face_builder_write()
+ *
+ * A virtual method for hb_face_builder_write(), called with each piece
+ * of the font file in order.  @data is only valid during the call.
+ *
+ * Return value: `true` to continue writing, `false` to stop
+ *
+ * Since: REPLACEME
+ */
+typedef hb_bool_t (*hb_face_builder_write_func_t) (hb_face_t  *face,
+						   const char *data,
+						   unsigned int length,
+						   void       *user_data);
+
+HB_EXTERN hb_bool_t
+hb_face_builder_write (hb_face_t                    *face,
+		       hb_face_builder_write_func_t  func,
+		       void                         *user_data);
+
+HB_EXTERN unsigned int
+hb_face_builder_reference_blobs (hb_face_t    *face,
+				 unsigned int  start_offset,
+				 unsigned int *blob_count, /* IN/OUT */
+				 hb_blob_t   **blobs /* OUT */);
+
 
 HB_END_DECLS
 
@@ -49,8 +49,13 @@ struct hb_lockable_set_t
 
   void init () { items.init (); }
 
-  template <typename T>
-  item_t *replace_or_insert (T v, lock_t &l, bool replace)
+  /* The changed callback, if any, is called with the lock held after
+   * the set is modified, and before any replaced item is finalized. */
+  struct no_callback_t { void operator () () const {} };
+
+  template <typename T, typename changed_t = no_callback_t>
+  item_t *replace_or_insert (T v, lock_t &l, bool replace,
+			     const changed_t &changed = changed_t ())
   {
     l.lock ();
     item_t *item = items.lsearch (v);
@@ -58,6 +63,7 @@ struct hb_lockable_set_t
       if (replace) {
 	item_t old = *item;
 	*item = v;
+	changed ();
 	l.unlock ();
 	old.fini ();
       }
@@ -67,13 +73,15 @@ struct hb_lockable_set_t
       }
     } else {
       item = items.push (v);
+      changed ();
       l.unlock ();
     }
     return items.in_error () ? nullptr : item;
   }
 
-  template <typename T>
-  void remove (T v, lock_t &l)
+  template <typename T, typename changed_t = no_callback_t>
+  void remove (T v, lock_t &l,
+	       const changed_t &changed = changed_t ())
   {
     l.lock ();
     item_t *item = items.lsearch (v);
@@ -82,6 +90,7 @@ struct hb_lockable_set_t
       item_t old = *item;
       *item = std::move (items.tail ());
       items.pop ();
+      changed ();
       l.unlock ();
       old.fini ();
     } else {
@@ -170,12 +179,113 @@ struct hb_user_data_array_t
     void fini () { if (destroy) destroy (data); }
   };
 
+  /* Readers do not take the lock; they scan a snapshot of the keys and
+   * data instead.  Writers update it under the lock whenever the items
+   * change: replacing the data of a key stores it into the snapshot in
+   * place, while adding or removing a key publishes a new snapshot.
+   * Superseded snapshots might still be scanned by readers, so they are
+   * only freed with the array itself.  To bound that memory, after
+   * max_snapshots of them readers go back to taking the lock. */
+  struct snapshot_item_t
+  {
+    hb_user_data_key_t *key;
+    hb_atomic_ptr_t<void> data;
+  };
+  struct snapshot_t
+  {
+    snapshot_t *retired;
+    unsigned int length;
+    /* Followed by length snapshot_item_t's. */
+
+    snapshot_item_t *arrayZ () { return reinterpret_cast<snapshot_item_t *> (this + 1); }
+    const snapshot_item_t *arrayZ () const { return reinterpret_cast<const snapshot_item_t *> (this + 1); }
+  };
+  static_assert (sizeof (snapshot_t) % alignof (snapshot_item_t) == 0, "");
+  static constexpr unsigned max_snapshots = 16;
+
   hb_mutex_t lock;
   hb_lockable_set_t<hb_user_data_item_t, hb_mutex_t> items;
+  hb_atomic_ptr_t<snapshot_t> snapshot;
+  snapshot_t *retired;
+  unsigned int num_snapshots;
 
-  void init () { lock.init (); items.init (); }
+  void init ()
+  {
+    lock.init ();
+    items.init ();
+    snapshot.init ();
+    retired = nullptr;
+    num_snapshots = 0;
+  }
 
-  void fini () { items.fini (lock); lock.fini (); }
+  void fini ()
+  {
+    /* Destroy callbacks may still look up the remaining items. */
+    retire (snapshot.get_relaxed ());
+    snapshot.set_relaxed (nullptr);
+    items.fini (lock);
+    while (retired)
+    {
+      snapshot_t *next = retired->retired;
+      hb_free (retired);
+      retired = next;
+    }
+    lock.fini ();
+  }
+
+  void retire (snapshot_t *old)
+  {
+    if (!old) return;
+    old->retired = retired;
+    retired = old;
+  }
+
+  /* Called with the lock held.  If allocation fails, or max_snapshots
+   * is reached, readers fall back to taking the lock. */
+  void publish ()
+  {
+    const hb_user_data_item_t *live = items.items.arrayZ;
+    unsigned int length = items.items.length;
+    snapshot_t *old = snapshot.get_relaxed ();
+
+    if (old && old->length == length)
+    {
+      unsigned int i = 0;
+      while (i < length && old->arrayZ ()[i].key == live[i].key)
+	i++;
+      if (i == length)
+      {
+	/* Same keys; only data was replaced.  Only writers store, and they
+	 * hold the lock, so just retry if the exchange fails spuriously. */
+	for (i = 0; i < length; i++)
+	{
+	  hb_atomic_ptr_t<void> &data = old->arrayZ ()[i].data;
+	  while (!data.cmpexch (data.get_relaxed (), live[i].data))
+	    ;
+	}
+	return;
+      }
+    }
+
+    snapshot_t *snap = nullptr;
+    if (num_snapshots < max_snapshots)
+      snap = (snapshot_t *) hb_malloc (sizeof (snapshot_t) +
+				       length * sizeof (snapshot_item_t));
+    if (likely (snap))
+    {
+      num_snapshots++;
+      snap->retired = nullptr;
+      snap->length = length;
+      for (unsigned int i = 0; i < length; i++)
+      {
+	snap->arrayZ ()[i].key = live[i].key;
+	snap->arrayZ ()[i].data.init (live[i].data);
+      }
+    }
+    while (!snapshot.cmpexch (old, snap))
+      ;
+    retire (old);
+  }
 
   bool set (hb_user_data_key_t *key,
 	    void *              data,
@@ -185,20 +295,30 @@ struct hb_user_data_array_t
     if (!key)
       return false;
 
+    auto changed = [this] () { publish (); };
     if (replace) {
       if (!data && !destroy) {
-	items.remove (key, lock);
+	items.remove (key, lock, changed);
 	return true;
       }
     }
     hb_user_data_item_t item = {key, data, destroy};
-    bool ret = !!items.replace_or_insert (item, lock, (bool) replace);
+    bool ret = !!items.replace_or_insert (item, lock, (bool) replace, changed);
 
     return ret;
   }
 
   void *get (hb_user_data_key_t *key)
   {
+    const snapshot_t *snap = snapshot.get_acquire ();
+    if (likely (snap))
+    {
+      for (const snapshot_item_t &item : hb_array (snap->arrayZ (), snap->length))
+	if (item.key == key)
+	  return item.data.get_acquire ();
+      return nullptr;
+    }
+
     hb_user_data_item_t item = {nullptr, nullptr, nullptr};
 
     return items.find (key, &item, lock) ? item.data : nullptr;
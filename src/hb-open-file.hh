@@ -197,6 +197,67 @@ typedef struct OpenTypeOffsetTable
     return_trace (true);
   }
 
+  /* The checksum serialize_directory() wants for table @tag, with
+   * data @blob. */
+  static uint32_t table_checksum (hb_tag_t tag, hb_blob_t *blob)
+  {
+    CheckSum checksum;
+    checksum.set_for_unpadded_data (blob->data, blob->length);
+    if (tag == HB_OT_TAG_head && blob->length >= head::static_size)
+      checksum = checksum - blob->as<head> ()->checkSumAdjustment;
+    return checksum;
+  }
+
+  /* Like serialize(), but only writes the table directory, from the
+   * tag, length and checksum of each table: the tables are to follow it
+   * in order, each padded to four bytes.  The checksum of the head table
+   * is to be taken with checkSumAdjustment set to zero; sets
+   * @checksum_adjustment to what it has to be set to then. */
+  template <typename Iterator,
+	    hb_requires ((hb_is_source_of<Iterator, hb_pair_t<hb_tag_t, hb_pair_t<unsigned, uint32_t>>>::value))>
+  bool serialize_directory (hb_serialize_context_t *c,
+			    hb_tag_t sfnt_tag,
+			    Iterator it,
+			    uint32_t *checksum_adjustment)
+  {
+    TRACE_SERIALIZE (this);
+    if (unlikely (!c->extend_min (this))) return_trace (false);
+    sfnt_version = sfnt_tag;
+    unsigned num_items = it.len ();
+    if (unlikely (!tables.serialize (c, num_items))) return_trace (false);
+
+    const unsigned dir_length = (const char *) c->head - (const char *) this;
+    unsigned offset = dir_length;
+    uint32_t checksum = 0;
+
+    unsigned i = 0;
+    for (hb_pair_t<hb_tag_t, hb_pair_t<unsigned, uint32_t>> entry : it)
+    {
+      unsigned len = entry.second.first;
+
+      TableRecord &rec = tables.arrayZ[i];
+      rec.tag = entry.first;
+      rec.length = len;
+      rec.offset = 0;
+      if (unlikely (!c->check_assign (rec.offset, offset,
+				      HB_SERIALIZE_ERROR_OFFSET_OVERFLOW) ||
+		    offset + hb_ceil_to_4 (len) < offset))
+        return_trace (false);
+      offset += hb_ceil_to_4 (len);
+
+      rec.checkSum = entry.second.second;
+      checksum += rec.checkSum;
+      i++;
+    }
+
+    tables.qsort ();
+
+    CheckSum dir_checksum;
+    dir_checksum.set_for_data (this, dir_length);
+    *checksum_adjustment = 0xB1B0AFBAu - (checksum + dir_checksum);
+    return_trace (true);
+  }
+
   bool sanitize (hb_sanitize_context_t *c) const
   {
     TRACE_SANITIZE (this);
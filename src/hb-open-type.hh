@@ -264,6 +264,18 @@ struct CheckSum : HBUINT32
   void set_for_data (const void *data, unsigned int length)
   { *this = CalcTableChecksum ((const HBUINT32 *) data, length); }
 
+  /* Same, for data that is not padded; it is checksummed as if it were,
+   * with zeros. */
+  void set_for_unpadded_data (const void *data, unsigned int length)
+  {
+    unsigned int padded_length = length & ~3u;
+    uint32_t sum = CalcTableChecksum ((const HBUINT32 *) data, padded_length);
+    const uint8_t *last = (const uint8_t *) data + padded_length;
+    for (unsigned int i = 0; i < length - padded_length; i++)
+      sum += (uint32_t) last[i] << (24 - 8 * i);
+    *this = sum;
+  }
+
   public:
   DEFINE_SIZE_STATIC (4);
 };
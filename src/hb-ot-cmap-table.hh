@@ -1227,7 +1227,7 @@ struct CmapSubtableFormat14
   {
     auto snap = c->snapshot ();
     unsigned table_initpos = c->length ();
-    const char* init_tail = c->tail;
+    unsigned init_tail = c->tail_length ();
 
     if (unlikely (!c->extend_min (this))) return;
     this->format = 14;
@@ -1264,7 +1264,7 @@ struct CmapSubtableFormat14
     if (unlikely (!c->check_success (!obj_indices.in_error ())))
       return;
 
-    int tail_len = init_tail - c->tail;
+    int tail_len = c->tail_length () - init_tail;
     c->check_assign (this->length, c->length () - table_initpos + tail_len,
                      HB_SERIALIZE_ERROR_INT_OVERFLOW);
     c->check_assign (this->record.len,
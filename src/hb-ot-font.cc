@@ -64,6 +64,25 @@
 using hb_ot_font_cmap_cache_t    = hb_cache_t<21, 16, 8, true>;
 using hb_ot_font_advance_cache_t = hb_cache_t<24, 16, 8, true>;
 
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+/* Metrics of variable glyf fonts that lack HVAR / VVAR come from the
+ * gvar-varied phantom points, which requires decoding every glyph.
+ * Those are cached separately, in larger caches, per coords serial. */
+struct hb_ot_font_phantom_cache_t
+{
+  void init ()
+  {
+    h_advances.init ();
+    v_advances.init ();
+    tsbs.init ();
+  }
+
+  hb_cache_t<24, 16, 12, true> h_advances;
+  hb_cache_t<24, 16, 10, true> v_advances;
+  hb_cache_t<24, 16, 10, true> tsbs; /* Biased by 0x8000. */
+};
+#endif
+
 #ifndef HB_NO_OT_FONT_CMAP_CACHE
 static hb_user_data_key_t hb_ot_font_cmap_cache_user_data_key;
 #endif
@@ -79,6 +98,12 @@ struct hb_ot_font_t
   /* h_advance caching */
   mutable hb_atomic_int_t cached_coords_serial;
   mutable hb_atomic_ptr_t<hb_ot_font_advance_cache_t> advance_cache;
+
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+  /* Phantom-point metrics caching */
+  mutable hb_atomic_int_t cached_phantom_coords_serial;
+  mutable hb_atomic_ptr_t<hb_ot_font_phantom_cache_t> phantom_cache;
+#endif
 };
 
 static hb_ot_font_t *
@@ -130,6 +155,11 @@ _hb_ot_font_destroy (void *font_data)
   auto *cache = ot_font->advance_cache.get_relaxed ();
   hb_free (cache);
 
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+  auto *phantom_cache = ot_font->phantom_cache.get_relaxed ();
+  hb_free (phantom_cache);
+#endif
+
   hb_free (ot_font);
 }
 
@@ -190,6 +220,37 @@ hb_ot_get_variation_glyph (hb_font_t *font HB_UNUSED,
                                              cmap_cache);
 }
 
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+static hb_ot_font_phantom_cache_t *
+_hb_ot_font_get_phantom_cache (const hb_ot_font_t *ot_font, hb_font_t *font)
+{
+retry:
+  hb_ot_font_phantom_cache_t *cache = ot_font->phantom_cache.get_acquire ();
+  if (unlikely (!cache))
+  {
+    cache = (hb_ot_font_phantom_cache_t *) hb_malloc (sizeof (hb_ot_font_phantom_cache_t));
+    if (unlikely (!cache))
+      return nullptr;
+
+    cache->init ();
+    if (unlikely (!ot_font->phantom_cache.cmpexch (nullptr, cache)))
+    {
+      hb_free (cache);
+      goto retry;
+    }
+    ot_font->cached_phantom_coords_serial.set_release (font->serial_coords);
+  }
+
+  if (ot_font->cached_phantom_coords_serial.get_acquire () != (int) font->serial_coords)
+  {
+    cache->init ();
+    ot_font->cached_phantom_coords_serial.set_release (font->serial_coords);
+  }
+
+  return cache;
+}
+#endif
+
 static void
 hb_ot_get_glyph_h_advances (hb_font_t* font, void* font_data,
 			    unsigned count,
@@ -209,9 +270,15 @@ hb_ot_get_glyph_h_advances (hb_font_t* font, void* font_data,
 #if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
   const OT::HVAR &HVAR = *hmtx.var_table;
   const OT::VariationStore &varStore = &HVAR + HVAR.varStore;
-  OT::VariationStore::cache_t *varStore_cache = font->num_coords * count >= 128 ? varStore.create_cache () : nullptr;
 
-  bool use_cache = font->num_coords;
+  /* No HVAR; advances come from glyf phantom points. */
+  hb_ot_font_phantom_cache_t *phantom_cache = nullptr;
+  if (font->num_coords && !hmtx.var_table.get_length ())
+    phantom_cache = _hb_ot_font_get_phantom_cache (ot_font, font);
+
+  OT::VariationStore::cache_t *varStore_cache = !phantom_cache && font->num_coords * count >= 128 ? varStore.create_cache () : nullptr;
+
+  bool use_cache = font->num_coords && !phantom_cache;
 #else
   OT::VariationStore::cache_t *varStore_cache = nullptr;
   bool use_cache = false;
@@ -242,6 +309,24 @@ hb_ot_get_glyph_h_advances (hb_font_t* font, void* font_data,
   }
   out:
 
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+  if (phantom_cache)
+  {
+    for (unsigned int i = 0; i < count; i++)
+    {
+      unsigned v;
+      if (!phantom_cache->h_advances.get (*first_glyph, &v))
+      {
+	v = hmtx.get_advance_with_var_unscaled (*first_glyph, font);
+	phantom_cache->h_advances.set (*first_glyph, v);
+      }
+      *first_advance = font->em_scale_x (v);
+      first_glyph = &StructAtOffsetUnaligned<hb_codepoint_t> (first_glyph, glyph_stride);
+      first_advance = &StructAtOffsetUnaligned<hb_position_t> (first_advance, advance_stride);
+    }
+  }
+  else
+#endif
   if (!use_cache)
   {
     for (unsigned int i = 0; i < count; i++)
@@ -314,11 +399,35 @@ hb_ot_get_glyph_v_advances (hb_font_t* font, void* font_data,
 #if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
     const OT::VVAR &VVAR = *vmtx.var_table;
     const OT::VariationStore &varStore = &VVAR + VVAR.varStore;
-    OT::VariationStore::cache_t *varStore_cache = font->num_coords ? varStore.create_cache () : nullptr;
+
+    /* No VVAR; advances come from glyf phantom points. */
+    hb_ot_font_phantom_cache_t *phantom_cache = nullptr;
+    if (font->num_coords && !vmtx.var_table.get_length ())
+      phantom_cache = _hb_ot_font_get_phantom_cache (ot_font, font);
+
+    OT::VariationStore::cache_t *varStore_cache = !phantom_cache && font->num_coords ? varStore.create_cache () : nullptr;
 #else
     OT::VariationStore::cache_t *varStore_cache = nullptr;
 #endif
 
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+    if (phantom_cache)
+    {
+      for (unsigned int i = 0; i < count; i++)
+      {
+	unsigned v;
+	if (!phantom_cache->v_advances.get (*first_glyph, &v))
+	{
+	  v = vmtx.get_advance_with_var_unscaled (*first_glyph, font);
+	  phantom_cache->v_advances.set (*first_glyph, v);
+	}
+	*first_advance = font->em_scale_y (-(int) v);
+	first_glyph = &StructAtOffsetUnaligned<hb_codepoint_t> (first_glyph, glyph_stride);
+	first_advance = &StructAtOffsetUnaligned<hb_position_t> (first_advance, advance_stride);
+      }
+    }
+    else
+#endif
     for (unsigned int i = 0; i < count; i++)
     {
       *first_advance = font->em_scale_y (-(int) vmtx.get_advance_with_var_unscaled (*first_glyph, font, varStore_cache));
@@ -395,7 +504,27 @@ hb_ot_get_glyph_v_origin (hb_font_t *font,
   {
     const OT::vmtx_accelerator_t &vmtx = *ot_face->vmtx;
     int tsb = 0;
-    if (vmtx.get_leading_bearing_with_var_unscaled (font, glyph, &tsb))
+    bool has_tsb;
+#if !defined(HB_NO_VAR) && !defined(HB_NO_OT_FONT_ADVANCE_CACHE)
+    hb_ot_font_phantom_cache_t *phantom_cache = nullptr;
+    if (font->num_coords && !vmtx.var_table.get_length ())
+      phantom_cache = _hb_ot_font_get_phantom_cache (ot_font, font);
+    unsigned cv;
+    if (phantom_cache && phantom_cache->tsbs.get (glyph, &cv))
+    {
+      tsb = (int) cv - 0x8000;
+      has_tsb = true;
+    }
+    else
+    {
+      has_tsb = vmtx.get_leading_bearing_with_var_unscaled (font, glyph, &tsb);
+      if (phantom_cache && has_tsb)
+	phantom_cache->tsbs.set (glyph, (unsigned) (tsb + 0x8000));
+    }
+#else
+    has_tsb = vmtx.get_leading_bearing_with_var_unscaled (font, glyph, &tsb);
+#endif
+    if (has_tsb)
     {
       *y = extents.y_bearing + font->em_scale_y (tsb);
       return true;
@@ -37,6 +37,17 @@
 #include "hb-ot-layout-common.hh"
 #include "hb-ot-layout-gdef-table.hh"
 
+/* Coverages with at least this many runs of consecutive glyphs are
+ * searched through Coverage::accelerator_t while shaping.  So are
+ * smaller ones whose set digest accepts at least the given fraction
+ * of the uncovered glyphs in between. */
+#ifndef HB_OT_LAYOUT_COVERAGE_ACCEL_MIN_RANGES
+#define HB_OT_LAYOUT_COVERAGE_ACCEL_MIN_RANGES 8
+#endif
+#ifndef HB_OT_LAYOUT_COVERAGE_ACCEL_DIGEST_FP_RATE
+#define HB_OT_LAYOUT_COVERAGE_ACCEL_DIGEST_FP_RATE .5f
+#endif
+
 
 namespace OT {
 
@@ -129,38 +140,84 @@ struct hb_closure_context_t :
   }
 
   const hb_set_t& previous_parent_active_glyphs () {
-    if (active_glyphs_stack.length <= 1)
+    if (active_glyphs_depth <= 1)
       return *glyphs;
 
-    return active_glyphs_stack[active_glyphs_stack.length - 2];
+    return active_glyphs_stack[active_glyphs_depth - 2];
   }
 
   const hb_set_t& parent_active_glyphs ()
   {
-    if (!active_glyphs_stack)
+    if (!active_glyphs_depth)
       return *glyphs;
 
-    return active_glyphs_stack.tail ();
+    return active_glyphs_stack[active_glyphs_depth - 1];
   }
 
   hb_set_t& push_cur_active_glyphs ()
   {
-    return *active_glyphs_stack.push ();
+    /* Popped sets stay in the stack and are cleared on reuse, such that
+     * recursing does not reallocate set pages for every rule.  A failed
+     * push counts towards the depth like in push_scratch_set (), so its
+     * pop_cur_done_glyphs () does not release the parent's set; the
+     * parent getters return an empty set for it. */
+    if (active_glyphs_depth == active_glyphs_stack.length)
+      active_glyphs_stack.resize (active_glyphs_depth + 1);
+
+    if (unlikely (active_glyphs_depth >= active_glyphs_stack.length))
+    {
+      active_glyphs_depth++;
+      return Crap (hb_set_t);
+    }
+
+    hb_set_t &s = active_glyphs_stack.arrayZ[active_glyphs_depth++];
+    s.clear ();
+    return s;
   }
 
   bool pop_cur_done_glyphs ()
   {
-    if (!active_glyphs_stack)
+    if (!active_glyphs_depth)
       return false;
 
-    active_glyphs_stack.pop ();
+    active_glyphs_depth--;
     return true;
   }
 
+  /* Temporary sets for the duration of one rule, recycled the same way.
+   * Held by pointer, since callers keep references across recursion.
+   * Every push must be matched by a pop, even if it failed: the depth
+   * counts failed pushes too, so a pop never releases an outer set. */
+  hb_set_t& push_scratch_set ()
+  {
+    if (scratch_sets_depth == scratch_sets.length &&
+	likely (scratch_sets.resize (scratch_sets_depth + 1)))
+      scratch_sets.tail () = hb::unique_ptr<hb_set_t> {hb_set_create ()};
+
+    if (unlikely (scratch_sets_depth >= scratch_sets.length))
+    {
+      scratch_sets_depth++;
+      return Crap (hb_set_t);
+    }
+
+    hb_set_t *s = scratch_sets.arrayZ[scratch_sets_depth++].get ();
+    s->clear ();
+    return *s;
+  }
+
+  void pop_scratch_set ()
+  {
+    if (scratch_sets_depth)
+      scratch_sets_depth--;
+  }
+
   hb_face_t *face;
   hb_set_t *glyphs;
   hb_set_t output[1];
   hb_vector_t<hb_set_t> active_glyphs_stack;
+  unsigned active_glyphs_depth = 0;
+  hb_vector_t<hb::unique_ptr<hb_set_t>> scratch_sets;
+  unsigned scratch_sets_depth = 0;
   recurse_func_t recurse_func = nullptr;
   unsigned int nesting_level_left;
 
@@ -185,8 +242,7 @@ struct hb_closure_context_t :
     output->del_range (face->get_num_glyphs (), HB_SET_VALUE_INVALID);	/* Remove invalid glyphs. */
     glyphs->union_ (*output);
     output->clear ();
-    active_glyphs_stack.pop ();
-    active_glyphs_stack.reset ();
+    active_glyphs_depth = 0;
   }
 
   private:
@@ -727,6 +783,10 @@ struct hb_ot_apply_context_t :
   signed last_base = -1; // GPOS uses
   unsigned last_base_until = 0; // GPOS uses
 
+  const Coverage *cur_coverage = nullptr;
+  hb_codepoint_t cur_coverage_glyph = 0;
+  unsigned cur_coverage_index = NOT_COVERED;
+
   hb_ot_apply_context_t (unsigned int table_index_,
 			 hb_font_t *font_,
 			 hb_buffer_t *buffer_) :
@@ -781,6 +841,22 @@ struct hb_ot_apply_context_t :
   void set_lookup_index (unsigned int lookup_index_) { lookup_index = lookup_index_; }
   void set_lookup_props (unsigned int lookup_props_) { lookup_props = lookup_props_; init_iters (); }
 
+  /* Coverage index of the current glyph in a subtable's main coverage.
+   * Reuses the index the lookup accelerator found on the way in, if any. */
+  void set_coverage_index (const Coverage &coverage, unsigned index)
+  {
+    cur_coverage = &coverage;
+    cur_coverage_glyph = buffer->cur().codepoint;
+    cur_coverage_index = index;
+  }
+  unsigned get_coverage_index (const Coverage &coverage) const
+  {
+    hb_codepoint_t g = buffer->cur().codepoint;
+    if (cur_coverage == &coverage && cur_coverage_glyph == g)
+      return cur_coverage_index;
+    return coverage.get_coverage (g);
+  }
+
   uint32_t random_number ()
   {
     /* http://www.cplusplus.com/reference/random/minstd_rand/ */
@@ -926,6 +1002,39 @@ struct hb_accelerate_subtables_context_t :
   typedef bool (*hb_apply_func_t) (const void *obj, hb_ot_apply_context_t *c);
   typedef bool (*hb_cache_func_t) (const void *obj, hb_ot_apply_context_t *c, bool enter);
 
+#if HB_DEBUG_DIGEST
+  /* How often glyphs a subtable does not cover got past its filters. */
+  struct digest_stats_t
+  {
+    void record (bool digest_pass, bool filter_pass, bool covered)
+    {
+      queries.inc ();
+      if (digest_pass) digest_passes.inc ();
+      if (filter_pass) filter_passes.inc ();
+      if (covered) this->covered.inc ();
+    }
+
+    void add (const digest_stats_t &o)
+    {
+      queries.set_relaxed (queries + o.queries);
+      digest_passes.set_relaxed (digest_passes + o.digest_passes);
+      filter_passes.set_relaxed (filter_passes + o.filter_passes);
+      covered.set_relaxed (covered + o.covered);
+    }
+
+    float false_positive_rate (int passes) const
+    {
+      int misses = queries - covered;
+      return misses ? 100.f * (passes - covered) / misses : 0.f;
+    }
+
+    hb_atomic_int_t queries;
+    hb_atomic_int_t digest_passes;
+    hb_atomic_int_t filter_passes;
+    hb_atomic_int_t covered;
+  };
+#endif
+
   struct hb_applicable_t
   {
     friend struct hb_accelerate_subtables_context_t;
@@ -946,18 +1055,48 @@ struct hb_accelerate_subtables_context_t :
       apply_cached_func = apply_cached_func_;
       cache_func = cache_func_;
 #endif
+      coverage = &obj_.get_coverage ();
       digest.init ();
-      obj_.get_coverage ().collect_coverage (&digest);
+      coverage->collect_coverage (&digest);
+
+      /* Large coverages are searched through a native-endian copy
+       * instead, which also catches what the digest lets through.
+       * Small ones only are if the digest does a poor job around
+       * them: glyphs being shaped tend to be close to each other in
+       * the font, so that is where false positives come from.  Both
+       * are judged from the table itself, so that the copy is only
+       * made when it is kept. */
+      if (coverage->get_range_count () >= HB_OT_LAYOUT_COVERAGE_ACCEL_MIN_RANGES ||
+	  coverage->false_positive_rate (digest) >= HB_OT_LAYOUT_COVERAGE_ACCEL_DIGEST_FP_RATE)
+	coverage_accel.init (*coverage);
+    }
+    void fini () { coverage_accel.fini (); }
+
+    bool may_apply (hb_ot_apply_context_t *c) const
+    {
+      hb_codepoint_t g = c->buffer->cur().codepoint;
+#if HB_DEBUG_DIGEST
+      stats.record (digest.may_have (g),
+		    digest.may_have (g) && (coverage_accel.is_empty () || coverage_accel.has (g)),
+		    coverage->has (g));
+#endif
+      if (!digest.may_have (g)) return false;
+      if (coverage_accel.is_empty ()) return true;
+
+      unsigned index = coverage_accel.get_coverage (g);
+      if (index == NOT_COVERED) return false;
+      c->set_coverage_index (*coverage, index);
+      return true;
     }
 
     bool apply (hb_ot_apply_context_t *c) const
     {
-      return digest.may_have (c->buffer->cur().codepoint) && apply_func (obj, c);
+      return may_apply (c) && apply_func (obj, c);
     }
 #ifndef HB_NO_OT_LAYOUT_LOOKUP_CACHE
     bool apply_cached (hb_ot_apply_context_t *c) const
     {
-      return digest.may_have (c->buffer->cur().codepoint) &&  apply_cached_func (obj, c);
+      return may_apply (c) &&  apply_cached_func (obj, c);
     }
     bool cache_enter (hb_ot_apply_context_t *c) const
     {
@@ -977,6 +1116,11 @@ struct hb_accelerate_subtables_context_t :
     hb_cache_func_t cache_func;
 #endif
     hb_set_digest_t digest;
+    const Coverage *coverage;
+    Coverage::accelerator_t coverage_accel;
+#if HB_DEBUG_DIGEST
+    mutable digest_stats_t stats;
+#endif
   };
 
 #ifndef HB_NO_OT_LAYOUT_LOOKUP_CACHE
@@ -1573,8 +1717,8 @@ static void context_closure_recurse_lookups (hb_closure_context_t *c,
 					     intersected_glyphs_func_t intersected_glyphs_func,
 					     void *cache)
 {
-  hb_set_t covered_seq_indicies;
-  hb_set_t pos_glyphs;
+  hb_set_t &covered_seq_indicies = c->push_scratch_set ();
+  hb_set_t &pos_glyphs = c->push_scratch_set ();
   for (unsigned int i = 0; i < lookupCount; i++)
   {
     unsigned seqIndex = lookupRecord[i].sequenceIndex;
@@ -1629,6 +1773,8 @@ static void context_closure_recurse_lookups (hb_closure_context_t *c,
 
     c->pop_cur_done_glyphs ();
   }
+  c->pop_scratch_set ();
+  c->pop_scratch_set ();
 }
 
 template <typename context_t>
@@ -2236,7 +2382,7 @@ struct ContextFormat1_4
   bool apply (hb_ot_apply_context_t *c) const
   {
     TRACE_APPLY (this);
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED))
       return_trace (false);
 
@@ -2456,7 +2602,7 @@ struct ContextFormat2_5
   bool _apply (hb_ot_apply_context_t *c, bool cached) const
   {
     TRACE_APPLY (this);
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const ClassDef &class_def = this+classDef;
@@ -2646,7 +2792,7 @@ struct ContextFormat3
   bool apply (hb_ot_apply_context_t *c) const
   {
     TRACE_APPLY (this);
-    unsigned int index = (this+coverageZ[0]).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverageZ[0]);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const LookupRecord *lookupRecord = &StructAfter<LookupRecord> (coverageZ.as_array (glyphCount));
@@ -3320,7 +3466,7 @@ struct ChainContextFormat1_4
   bool apply (hb_ot_apply_context_t *c) const
   {
     TRACE_APPLY (this);
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const ChainRuleSet &rule_set = this+ruleSet[index];
@@ -3561,7 +3707,7 @@ struct ChainContextFormat2_5
   bool _apply (hb_ot_apply_context_t *c, bool cached) const
   {
     TRACE_APPLY (this);
-    unsigned int index = (this+coverage).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+coverage);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const ClassDef &backtrack_class_def = this+backtrackClassDef;
@@ -3810,7 +3956,7 @@ struct ChainContextFormat3
     TRACE_APPLY (this);
     const auto &input = StructAfter<decltype (inputX)> (backtrack);
 
-    unsigned int index = (this+input[0]).get_coverage (c->buffer->cur().codepoint);
+    unsigned int index = c->get_coverage_index (this+input[0]);
     if (likely (index == NOT_COVERED)) return_trace (false);
 
     const auto &lookahead = StructAfter<decltype (lookaheadX)> (input);
@@ -4075,6 +4221,7 @@ struct hb_ot_layout_lookup_accelerator_t
     hb_accelerate_subtables_context_t c_accelerate_subtables (thiz->subtables);
     lookup.dispatch (&c_accelerate_subtables);
 
+    thiz->count = count;
     thiz->digest.init ();
     for (auto& subtable : hb_iter (thiz->subtables, count))
       thiz->digest.add (subtable.digest);
@@ -4089,9 +4236,35 @@ struct hb_ot_layout_lookup_accelerator_t
     return thiz;
   }
 
+  static void destroy (hb_ot_layout_lookup_accelerator_t *accel)
+  {
+    if (!accel) return;
+    for (auto& subtable : hb_iter (accel->subtables, accel->count))
+      subtable.fini ();
+    hb_free (accel);
+  }
+
   bool may_have (hb_codepoint_t g) const
   { return digest.may_have (g); }
 
+#if HB_DEBUG_DIGEST
+  void report_digest_stats (hb_tag_t table_tag, unsigned lookup_index) const
+  {
+    hb_accelerate_subtables_context_t::digest_stats_t stats;
+    for (auto& subtable : hb_iter (subtables, count))
+      stats.add (subtable.stats);
+    if (!stats.queries) return;
+
+    DEBUG_MSG (DIGEST, nullptr,
+	       "%c%c%c%c lookup %u: %u subtables, %d queries, %d covered; "
+	       "false positives: digest %.1f%%, with coverage filter %.1f%%",
+	       HB_UNTAG (table_tag), lookup_index, count,
+	       (int) stats.queries, (int) stats.covered,
+	       (double) stats.false_positive_rate (stats.digest_passes),
+	       (double) stats.false_positive_rate (stats.filter_passes));
+  }
+#endif
+
   bool apply (hb_ot_apply_context_t *c, unsigned subtables_count, bool use_cache) const
   {
 #ifndef HB_NO_OT_LAYOUT_LOOKUP_CACHE
@@ -4134,6 +4307,7 @@ struct hb_ot_layout_lookup_accelerator_t
 
   hb_set_digest_t digest;
   private:
+  unsigned count;
 #ifndef HB_NO_OT_LAYOUT_LOOKUP_CACHE
   unsigned cache_user_idx = (unsigned) -1;
 #endif
@@ -4523,7 +4697,13 @@ struct GSUBGPOS
     ~accelerator_t ()
     {
       for (unsigned int i = 0; i < this->lookup_count; i++)
-	hb_free (this->accels[i]);
+      {
+#if HB_DEBUG_DIGEST
+	if (auto *accel = this->accels[i].get_relaxed ())
+	  accel->report_digest_stats (T::tableTag, i);
+#endif
+	hb_ot_layout_lookup_accelerator_t::destroy (this->accels[i]);
+      }
       hb_free (this->accels);
       this->table.destroy ();
     }
@@ -4542,7 +4722,7 @@ struct GSUBGPOS
 
 	if (unlikely (!accels[lookup_index].cmpexch (nullptr, accel)))
 	{
-	  hb_free (accel);
+	  hb_ot_layout_lookup_accelerator_t::destroy (accel);
 	  goto retry;
 	}
       }
@@ -87,13 +87,6 @@ hb_ot_map_builder_t::hb_ot_map_builder_t (hb_face_t *face_,
   }
 }
 
-hb_ot_map_builder_t::~hb_ot_map_builder_t ()
-{
-  feature_infos.fini ();
-  for (unsigned int table_index = 0; table_index < 2; table_index++)
-    stages[table_index].fini ();
-}
-
 void hb_ot_map_builder_t::add_feature (hb_tag_t tag,
 				       hb_ot_map_feature_flags_t flags,
 				       unsigned int value)
@@ -244,6 +237,7 @@ hb_ot_map_builder_t::compile (hb_ot_map_t                  &m,
   unsigned int next_bit = hb_popcount (HB_GLYPH_FLAG_DEFINED) + 1;
 
   unsigned count = feature_infos.length;
+  m.features.alloc (count);
   for (unsigned int i = 0; i < count; i++)
   {
     const feature_info_t *info = &feature_infos[i];
@@ -323,6 +317,7 @@ hb_ot_map_builder_t::compile (hb_ot_map_t                  &m,
   {
     /* Collect lookup indices for features */
     auto &lookups = m.lookups[table_index];
+    m.stages[table_index].alloc (stages[table_index].length, true);
 
     unsigned int stage_index = 0;
     unsigned int last_num_lookups = 0;
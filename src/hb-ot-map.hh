@@ -205,8 +205,6 @@ struct hb_ot_map_builder_t
   HB_INTERNAL hb_ot_map_builder_t (hb_face_t *face_,
 				   const hb_segment_properties_t &props_);
 
-  HB_INTERNAL ~hb_ot_map_builder_t ();
-
   HB_INTERNAL void add_feature (hb_tag_t tag,
 				hb_ot_map_feature_flags_t flags=F_NONE,
 				unsigned int value=1);
@@ -281,8 +279,10 @@ struct hb_ot_map_builder_t
   private:
 
   unsigned int current_stage[2]; /* GSUB/GPOS */
-  hb_vector_t<feature_info_t> feature_infos;
-  hb_vector_t<stage_info_t> stages[2]; /* GSUB/GPOS */
+  /* The builder lives on the stack for the duration of plan compilation;
+   * size these so that common scripts never allocate. */
+  hb_small_vector_t<feature_info_t, 48> feature_infos;
+  hb_small_vector_t<stage_info_t, 16> stages[2]; /* GSUB/GPOS */
 };
 
 
@@ -323,6 +323,24 @@ _hb_ot_shape_normalize (const hb_ot_shape_plan_t *plan,
 			      mode != HB_OT_SHAPE_NORMALIZATION_MODE_COMPOSED_DIACRITICS_NO_SHORT_CIRCUIT);
   unsigned int count;
 
+  /* Without any marks every cluster is simple, and there is nothing to
+   * reorder or recompose.  If the font also has all the characters, none
+   * of them gets decomposed either, and normalization comes down to the
+   * cmap lookup, which we do in place without touching the out-buffer.
+   * Otherwise carry on from the first character the font is missing. */
+  unsigned int mapped = 0;
+  if (might_short_circuit &&
+      !(buffer->scratch_flags & HB_BUFFER_SCRATCH_FLAG_HAS_UNICODE_MARKS))
+  {
+    mapped = font->get_nominal_glyphs (buffer->len,
+				       &buffer->info[0].codepoint,
+				       sizeof (buffer->info[0]),
+				       &buffer->info[0].glyph_index(),
+				       sizeof (buffer->info[0]));
+    if (likely (mapped == buffer->len))
+      return;
+  }
+
   /* We do a fairly straightforward yet custom normalization process in three
    * separate rounds: decompose, reorder, recompose (if desired).  Currently
    * this makes two buffer swaps.  We can make it faster by moving the last
@@ -337,6 +355,7 @@ _hb_ot_shape_normalize (const hb_ot_shape_plan_t *plan,
     buffer->clear_output ();
     count = buffer->len;
     buffer->idx = 0;
+    (void) buffer->next_glyphs (mapped); /* In place; cannot fail. */
     do
     {
       unsigned int end;
@@ -358,7 +377,27 @@ _hb_ot_shape_normalize (const hb_ot_shape_plan_t *plan,
 	if (unlikely (!buffer->next_glyphs (done))) break;
       }
       while (buffer->idx < end && buffer->successful)
+      {
+	if (!might_short_circuit)
+	{
+	  /* Nothing below U+00C0 has a canonical decomposition; map runs
+	   * of those straight through cmap instead of trying each one. */
+	  unsigned int run_end = buffer->idx;
+	  while (run_end < end && buffer->info[run_end].codepoint < 0x00C0u)
+	    run_end++;
+	  if (run_end > buffer->idx)
+	  {
+	    unsigned int done = font->get_nominal_glyphs (run_end - buffer->idx,
+							  &buffer->cur().codepoint,
+							  sizeof (buffer->info[0]),
+							  &buffer->cur().glyph_index(),
+							  sizeof (buffer->info[0]));
+	    if (unlikely (!buffer->next_glyphs (done))) break;
+	    if (buffer->idx == end) break;
+	  }
+	}
 	decompose_current_character (&c, might_short_circuit);
+      }
 
       if (buffer->idx == count || !buffer->successful)
 	break;
@@ -465,9 +465,22 @@ hb_set_unicode_props (hb_buffer_t *buffer)
    */
   unsigned int count = buffer->len;
   hb_glyph_info_t *info = buffer->info;
+
+  /* General categories are fetched a batch at a time. */
+  hb_unicode_general_category_t gen_cats[64];
+  unsigned int batch_start = 0, batch_end = 0;
+
   for (unsigned int i = 0; i < count; i++)
   {
-    _hb_glyph_info_set_unicode_props (&info[i], buffer);
+    if (i >= batch_end)
+    {
+      batch_start = i;
+      batch_end = hb_min (count, i + (unsigned) ARRAY_LENGTH (gen_cats));
+      buffer->unicode->general_categories (batch_end - batch_start,
+					   &info[i].codepoint, sizeof (info[0]),
+					   gen_cats, sizeof (gen_cats[0]));
+    }
+    _hb_glyph_info_set_unicode_props (&info[i], buffer, gen_cats[i - batch_start]);
 
     /* Marks are already set as continuation by the above line.
      * Handle Emoji_Modifier and ZWJ-continuation. */
@@ -688,12 +701,20 @@ hb_ot_rotate_chars (const hb_ot_shape_context_t *c)
     hb_unicode_funcs_t *unicode = buffer->unicode;
     hb_mask_t rtlm_mask = c->plan->rtlm_mask;
 
-    for (unsigned int i = 0; i < count; i++) {
-      hb_codepoint_t codepoint = unicode->mirroring (info[i].codepoint);
-      if (unlikely (codepoint != info[i].codepoint && c->font->has_glyph (codepoint)))
-	info[i].codepoint = codepoint;
-      else
-	info[i].mask |= rtlm_mask;
+    hb_codepoint_t mirrors[64];
+    for (unsigned int start = 0; start < count; start += ARRAY_LENGTH (mirrors))
+    {
+      unsigned int end = hb_min (count, start + (unsigned) ARRAY_LENGTH (mirrors));
+      unicode->mirrorings (end - start,
+			   &info[start].codepoint, sizeof (info[0]),
+			   mirrors, sizeof (mirrors[0]));
+      for (unsigned int i = start; i < end; i++) {
+	hb_codepoint_t codepoint = mirrors[i - start];
+	if (unlikely (codepoint != info[i].codepoint && c->font->has_glyph (codepoint)))
+	  info[i].codepoint = codepoint;
+	else
+	  info[i].mask |= rtlm_mask;
+      }
     }
   }
 
@@ -219,6 +219,33 @@ static const LangTag ot_languages2[] = {
   {HB_TAG('z','u',' ',' '),	HB_TAG('Z','U','L',' ')},	/* Zulu */
 };
 
+/* Perfect hash from language to the index + 1 of its first row in
+ * ot_languages2.  See ot_languages_lookup(). */
+static const uint8_t ot_languages2_hash_seeds[] = {
+  0, 2, 0, 0, 11, 1, 0, 0, 1, 3, 10, 0, 0, 1, 2, 0,
+  0, 4, 0, 0, 7, 2, 1, 20, 6, 0, 2, 9, 3, 11, 3, 11,
+  7, 3, 1, 17, 2, 6, 2, 16, 2, 28, 20, 0, 0, 0, 4, 1,
+  1, 1, 19, 3, 0, 1, 2, 69, 0, 0, 2, 13, 12, 5, 12, 10,
+};
+static const uint16_t ot_languages2_hash_slots[] = {
+  0, 181, 0, 105, 119, 149, 0, 145, 147, 73, 62, 49, 1, 45, 90, 164,
+  201, 182, 124, 163, 29, 35, 139, 31, 0, 0, 148, 191, 198, 0, 100, 196,
+  0, 186, 51, 158, 108, 37, 0, 12, 0, 0, 106, 0, 4, 40, 0, 153,
+  0, 0, 2, 56, 25, 97, 179, 14, 80, 26, 0, 99, 0, 116, 102, 0,
+  133, 150, 44, 24, 169, 0, 0, 33, 142, 41, 165, 30, 0, 75, 168, 146,
+  174, 74, 141, 32, 175, 130, 13, 193, 0, 144, 88, 67, 68, 190, 161, 0,
+  72, 89, 109, 127, 0, 183, 58, 0, 125, 178, 36, 55, 0, 192, 188, 172,
+  28, 94, 11, 0, 3, 200, 154, 83, 110, 176, 0, 10, 0, 132, 52, 0,
+  152, 15, 0, 156, 0, 0, 199, 0, 0, 38, 0, 47, 128, 0, 121, 134,
+  189, 0, 0, 0, 87, 140, 107, 91, 39, 177, 0, 0, 162, 0, 122, 21,
+  104, 113, 84, 95, 129, 53, 0, 171, 0, 101, 27, 0, 23, 79, 0, 65,
+  57, 61, 137, 9, 203, 123, 103, 17, 54, 0, 0, 46, 0, 0, 0, 184,
+  0, 69, 64, 19, 157, 0, 0, 155, 151, 48, 82, 85, 170, 0, 98, 0,
+  114, 138, 197, 77, 78, 92, 8, 136, 0, 143, 180, 111, 0, 173, 0, 118,
+  167, 86, 6, 0, 7, 0, 20, 166, 50, 0, 71, 93, 42, 194, 131, 22,
+  195, 5, 115, 43, 0, 126, 0, 0, 112, 59, 18, 0, 0, 202, 185, 0,
+};
+
 #ifndef HB_NO_LANGUAGE_LONG
 static const LangTag ot_languages3[] = {
   {HB_TAG('a','a','e',' '),	HB_TAG('S','Q','I',' ')},	/* Arbëreshë Albanian -> Albanian */
@@ -1622,6 +1649,157 @@ static const LangTag ot_languages3[] = {
 /*{HB_TAG('z','z','a',' '),	HB_TAG('Z','Z','A',' ')},*/	/* Zazaki [macrolanguage] */
   {HB_TAG('z','z','j',' '),	HB_TAG('Z','H','A',' ')},	/* Zuojiang Zhuang -> Zhuang */
 };
+
+/* Perfect hash from language to the index + 1 of its first row in
+ * ot_languages3.  See ot_languages_lookup(). */
+static const uint8_t ot_languages3_hash_seeds[] = {
+  0, 0, 3, 3, 0, 1, 0, 4, 1, 6, 0, 3, 0, 8, 0, 0,
+  1, 4, 0, 0, 1, 0, 0, 0, 7, 0, 4, 4, 2, 3, 2, 1,
+  1, 10, 5, 12, 1, 2, 1, 0, 0, 1, 1, 3, 3, 2, 1, 1,
+  2, 3, 5, 0, 2, 0, 0, 5, 3, 0, 0, 0, 0, 8, 1, 8,
+  2, 4, 0, 1, 3, 4, 0, 15, 1, 1, 1, 0, 1, 0, 11, 3,
+  15, 3, 1, 10, 2, 0, 2, 0, 0, 2, 1, 0, 6, 0, 2, 1,
+  10, 0, 5, 6, 1, 13, 0, 13, 5, 9, 1, 2, 6, 0, 0, 0,
+  2, 15, 1, 3, 9, 16, 0, 7, 7, 1, 0, 0, 3, 31, 0, 0,
+  1, 0, 0, 6, 3, 2, 2, 0, 7, 0, 0, 0, 1, 16, 9, 4,
+  4, 2, 15, 2, 5, 0, 8, 4, 0, 1, 10, 7, 2, 0, 5, 6,
+  1, 0, 9, 1, 7, 0, 1, 22, 2, 8, 7, 0, 0, 1, 1, 5,
+  7, 3, 4, 6, 0, 11, 5, 0, 4, 1, 14, 0, 7, 0, 0, 2,
+  6, 0, 1, 1, 7, 1, 6, 9, 0, 0, 2, 7, 2, 2, 5, 0,
+  0, 11, 3, 0, 15, 11, 17, 13, 14, 4, 16, 0, 0, 0, 1, 20,
+  2, 1, 0, 30, 5, 1, 2, 7, 0, 2, 1, 4, 0, 1, 2, 7,
+  10, 0, 4, 1, 1, 2, 1, 12, 9, 10, 9, 0, 1, 18, 0, 3,
+};
+static const uint16_t ot_languages3_hash_slots[] = {
+  0, 0, 362, 0, 148, 368, 879, 23, 187, 1082, 1105, 0, 882, 776, 161, 57,
+  0, 0, 112, 1057, 210, 66, 613, 732, 0, 578, 1108, 486, 573, 0, 0, 205,
+  0, 0, 44, 352, 0, 0, 0, 372, 0, 18, 0, 0, 0, 1205, 334, 1169,
+  635, 0, 0, 0, 697, 653, 1118, 0, 655, 0, 104, 1148, 353, 0, 922, 827,
+  169, 0, 944, 0, 361, 0, 0, 0, 163, 0, 867, 0, 630, 0, 0, 1033,
+  384, 0, 1066, 0, 0, 1207, 193, 0, 136, 0, 0, 0, 0, 0, 327, 0,
+  0, 0, 463, 0, 0, 0, 786, 935, 0, 0, 948, 554, 0, 0, 0, 0,
+  0, 1054, 580, 891, 764, 0, 0, 521, 1161, 0, 354, 0, 0, 795, 0, 506,
+  0, 0, 0, 0, 0, 0, 1050, 122, 460, 680, 216, 0, 0, 402, 552, 773,
+  0, 844, 0, 105, 975, 725, 371, 681, 1101, 560, 0, 0, 1143, 0, 0, 0,
+  0, 0, 0, 0, 0, 91, 785, 213, 226, 0, 49, 0, 260, 1181, 0, 519,
+  1170, 0, 0, 50, 0, 388, 0, 541, 860, 306, 0, 0, 0, 634, 645, 0,
+  453, 0, 931, 478, 606, 0, 812, 0, 708, 177, 0, 0, 0, 0, 820, 0,
+  0, 593, 700, 1011, 0, 612, 0, 0, 0, 0, 438, 0, 873, 848, 866, 802,
+  0, 225, 0, 477, 8, 1038, 26, 0, 1186, 799, 322, 0, 0, 1106, 1080, 317,
+  324, 24, 584, 413, 0, 0, 774, 1097, 267, 245, 0, 0, 0, 808, 314, 0,
+  0, 0, 949, 339, 1142, 0, 117, 0, 0, 698, 171, 1084, 0, 0, 0, 0,
+  871, 1122, 835, 846, 992, 589, 1176, 110, 332, 838, 0, 904, 270, 714, 0, 0,
+  524, 0, 622, 1010, 134, 1178, 1043, 0, 0, 0, 1021, 591, 971, 978, 0, 0,
+  0, 0, 881, 435, 1008, 0, 0, 726, 0, 0, 379, 0, 0, 575, 0, 0,
+  703, 0, 0, 682, 305, 738, 0, 0, 0, 668, 412, 1074, 0, 401, 577, 995,
+  1113, 0, 0, 0, 557, 0, 114, 983, 1125, 0, 0, 0, 0, 0, 0, 604,
+  753, 811, 0, 605, 993, 0, 0, 1029, 0, 617, 227, 0, 850, 771, 1041, 1129,
+  951, 1069, 0, 0, 945, 0, 727, 418, 0, 906, 637, 479, 662, 356, 0, 1204,
+  760, 80, 186, 523, 0, 307, 0, 203, 602, 0, 743, 0, 0, 0, 0, 1078,
+  135, 958, 9, 547, 960, 0, 0, 312, 87, 0, 442, 179, 724, 853, 1201, 767,
+  0, 1024, 0, 0, 0, 326, 0, 5, 832, 794, 0, 601, 469, 89, 964, 201,
+  219, 0, 119, 0, 0, 0, 0, 0, 0, 7, 0, 733, 62, 458, 1051, 0,
+  191, 0, 0, 0, 0, 239, 1059, 0, 0, 0, 0, 0, 271, 574, 0, 1085,
+  0, 230, 683, 0, 1103, 0, 893, 0, 0, 0, 0, 0, 0, 0, 0, 728,
+  0, 599, 123, 0, 1174, 731, 1198, 1052, 357, 0, 194, 0, 765, 729, 11, 0,
+  93, 165, 0, 937, 404, 537, 598, 0, 0, 757, 0, 255, 0, 1175, 0, 0,
+  394, 0, 0, 0, 389, 0, 0, 0, 828, 373, 561, 495, 0, 0, 0, 566,
+  0, 426, 0, 822, 650, 374, 533, 621, 715, 0, 235, 0, 38, 569, 55, 0,
+  464, 0, 0, 797, 863, 0, 974, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 1083, 0, 417, 0, 0, 448, 482, 749, 1015, 596, 656, 0, 0,
+  614, 0, 475, 525, 0, 804, 0, 0, 0, 0, 633, 47, 0, 53, 0, 849,
+  1088, 15, 0, 954, 0, 973, 553, 0, 0, 809, 0, 0, 484, 0, 79, 157,
+  0, 0, 492, 0, 0, 81, 0, 0, 0, 397, 0, 0, 0, 0, 884, 0,
+  0, 616, 0, 1100, 917, 1111, 0, 0, 0, 0, 1049, 0, 0, 0, 172, 0,
+  0, 0, 0, 0, 470, 0, 0, 242, 0, 976, 0, 0, 253, 96, 0, 331,
+  0, 0, 0, 1177, 0, 967, 0, 0, 0, 0, 1044, 367, 0, 502, 0, 0,
+  0, 636, 0, 836, 0, 281, 0, 1003, 551, 13, 466, 33, 0, 0, 0, 0,
+  489, 0, 0, 1180, 1200, 0, 0, 494, 752, 0, 0, 0, 0, 579, 0, 669,
+  0, 196, 912, 0, 550, 0, 456, 0, 952, 784, 0, 222, 0, 755, 0, 826,
+  991, 360, 1155, 712, 0, 0, 106, 493, 674, 0, 0, 0, 511, 638, 180, 1157,
+  988, 407, 348, 0, 0, 0, 1004, 825, 1046, 667, 1035, 0, 0, 0, 545, 0,
+  61, 0, 542, 1133, 16, 990, 0, 276, 939, 709, 0, 0, 982, 406, 933, 0,
+  0, 0, 619, 0, 695, 386, 955, 0, 666, 1112, 0, 4, 840, 1127, 876, 0,
+  218, 399, 0, 0, 0, 64, 0, 377, 769, 0, 1005, 257, 1076, 121, 0, 567,
+  0, 0, 0, 0, 0, 998, 189, 0, 0, 0, 0, 624, 34, 0, 2, 0,
+  1192, 0, 746, 0, 140, 961, 539, 0, 0, 673, 1086, 594, 395, 0, 0, 1012,
+  620, 1090, 251, 288, 0, 972, 1025, 0, 51, 538, 0, 0, 0, 0, 0, 0,
+  1040, 898, 503, 1172, 689, 1190, 383, 1014, 108, 1036, 571, 783, 1063, 0, 0, 164,
+  0, 0, 0, 0, 660, 0, 0, 0, 0, 0, 0, 796, 0, 358, 558, 0,
+  45, 625, 443, 0, 342, 0, 40, 323, 1031, 162, 0, 476, 0, 0, 0, 1138,
+  0, 280, 0, 0, 0, 337, 690, 0, 500, 0, 228, 3, 0, 0, 864, 611,
+  632, 0, 0, 0, 298, 150, 0, 272, 672, 661, 0, 1191, 0, 780, 0, 190,
+  0, 929, 92, 0, 381, 0, 1123, 1130, 376, 297, 70, 434, 380, 710, 0, 0,
+  747, 382, 0, 751, 0, 0, 1068, 0, 445, 0, 0, 0, 852, 1107, 0, 0,
+  926, 147, 166, 0, 0, 491, 0, 0, 648, 0, 120, 223, 0, 0, 173, 0,
+  0, 0, 0, 0, 100, 310, 0, 0, 0, 0, 1027, 439, 0, 1124, 858, 0,
+  0, 921, 0, 800, 0, 742, 940, 582, 396, 744, 329, 474, 133, 544, 821, 109,
+  1030, 0, 0, 0, 0, 507, 1131, 762, 0, 224, 0, 720, 750, 0, 0, 1193,
+  0, 0, 716, 1072, 1055, 0, 0, 0, 0, 0, 834, 915, 0, 0, 0, 60,
+  452, 1126, 39, 207, 0, 146, 770, 0, 0, 722, 0, 0, 437, 0, 0, 28,
+  0, 220, 0, 125, 1001, 823, 43, 420, 498, 1168, 1202, 0, 627, 1045, 0, 101,
+  423, 1065, 0, 408, 398, 0, 0, 0, 1092, 615, 0, 208, 1171, 138, 0, 0,
+  0, 0, 1091, 996, 414, 0, 0, 0, 375, 0, 0, 248, 0, 262, 0, 0,
+  115, 0, 184, 274, 36, 419, 0, 0, 0, 788, 118, 0, 1053, 1150, 517, 851,
+  0, 0, 126, 0, 283, 0, 0, 0, 0, 0, 385, 818, 416, 756, 0, 0,
+  603, 95, 651, 652, 0, 454, 151, 0, 1047, 0, 0, 0, 0, 0, 343, 1102,
+  0, 0, 902, 833, 0, 737, 296, 957, 1098, 623, 0, 499, 0, 1016, 473, 0,
+  0, 0, 0, 0, 139, 1060, 1002, 0, 393, 0, 0, 0, 85, 0, 699, 0,
+  529, 215, 1023, 211, 0, 1064, 806, 0, 0, 0, 0, 0, 0, 0, 0, 370,
+  0, 0, 425, 304, 0, 0, 234, 576, 516, 1017, 678, 1007, 1019, 83, 0, 455,
+  0, 0, 528, 0, 0, 137, 467, 549, 0, 0, 0, 233, 900, 629, 0, 0,
+  0, 0, 618, 67, 0, 0, 0, 0, 0, 192, 214, 0, 160, 0, 1061, 1185,
+  0, 0, 0, 1110, 0, 0, 0, 488, 77, 421, 0, 430, 0, 202, 0, 0,
+  294, 0, 0, 0, 355, 508, 347, 0, 209, 0, 707, 1173, 46, 0, 0, 572,
+  0, 735, 688, 71, 0, 25, 0, 0, 0, 1164, 0, 0, 0, 0, 713, 0,
+  927, 0, 441, 496, 0, 0, 642, 778, 0, 0, 1152, 0, 410, 345, 0, 0,
+  919, 0, 0, 319, 0, 0, 0, 1189, 0, 956, 0, 0, 252, 609, 0, 0,
+  128, 0, 0, 0, 0, 0, 0, 0, 436, 0, 0, 1203, 694, 0, 0, 842,
+  0, 0, 0, 0, 59, 0, 0, 0, 0, 564, 0, 1154, 400, 730, 0, 0,
+  0, 0, 0, 0, 807, 0, 0, 981, 22, 12, 0, 965, 0, 643, 704, 0,
+  1037, 99, 1034, 424, 0, 346, 817, 0, 1197, 0, 590, 0, 0, 0, 1149, 745,
+  0, 0, 0, 1159, 532, 0, 481, 801, 1208, 1199, 159, 221, 1026, 459, 1182, 0,
+  316, 0, 518, 1028, 94, 333, 0, 1077, 0, 315, 717, 76, 0, 512, 670, 158,
+  142, 1135, 0, 515, 775, 857, 0, 403, 0, 313, 446, 0, 0, 0, 82, 966,
+  428, 303, 0, 1022, 962, 0, 0, 0, 0, 816, 212, 0, 861, 0, 0, 0,
+  432, 480, 696, 0, 0, 628, 30, 942, 183, 0, 0, 886, 1195, 843, 754, 0,
+  302, 1039, 787, 65, 0, 293, 0, 1000, 0, 644, 0, 0, 259, 27, 1167, 830,
+  102, 0, 462, 132, 116, 959, 0, 0, 0, 0, 63, 0, 261, 0, 0, 586,
+  0, 0, 0, 0, 0, 789, 0, 1153, 97, 0, 1013, 0, 0, 465, 29, 433,
+  0, 793, 1075, 144, 0, 501, 1006, 0, 309, 330, 20, 0, 0, 143, 0, 0,
+  897, 124, 0, 0, 320, 970, 0, 0, 0, 0, 0, 0, 583, 0, 0, 819,
+  0, 41, 665, 0, 0, 0, 1121, 878, 597, 0, 0, 155, 536, 531, 664, 54,
+  1070, 1132, 0, 129, 748, 0, 0, 782, 0, 0, 889, 862, 0, 869, 0, 0,
+  608, 640, 987, 204, 0, 0, 0, 0, 0, 631, 409, 0, 0, 654, 0, 0,
+  0, 231, 461, 1114, 0, 0, 1093, 0, 588, 0, 0, 485, 318, 0, 264, 1062,
+  986, 0, 0, 0, 415, 739, 0, 0, 0, 0, 369, 1206, 761, 0, 803, 285,
+  48, 719, 0, 1056, 0, 0, 113, 790, 0, 1147, 0, 657, 847, 831, 0, 984,
+  0, 0, 0, 1018, 0, 206, 422, 0, 0, 0, 0, 0, 0, 0, 562, 0,
+  999, 0, 131, 0, 449, 75, 968, 0, 300, 1120, 0, 758, 0, 1179, 0, 829,
+  0, 711, 768, 0, 321, 291, 855, 0, 0, 0, 0, 0, 0, 232, 1109, 1115,
+  141, 0, 0, 1141, 0, 0, 910, 0, 0, 0, 1089, 0, 0, 610, 181, 440,
+  548, 687, 527, 217, 170, 509, 457, 0, 1020, 0, 0, 1144, 1184, 813, 0, 0,
+  0, 153, 0, 0, 0, 0, 1146, 677, 229, 487, 845, 0, 585, 686, 0, 856,
+  0, 340, 0, 0, 781, 0, 0, 647, 0, 0, 0, 1209, 0, 0, 0, 0,
+  0, 284, 0, 0, 0, 0, 286, 88, 42, 0, 675, 791, 0, 595, 1188, 1196,
+  763, 0, 702, 0, 565, 1158, 0, 0, 772, 0, 130, 692, 0, 0, 289, 0,
+  301, 0, 6, 736, 263, 556, 0, 0, 1194, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 977, 0, 997, 0, 0, 0, 894, 338, 1160, 0, 52,
+  0, 0, 308, 0, 182, 450, 0, 86, 21, 268, 335, 723, 0, 1140, 197, 185,
+  985, 0, 559, 350, 405, 0, 0, 600, 69, 490, 0, 0, 98, 0, 269, 0,
+  0, 0, 0, 0, 378, 0, 275, 68, 535, 659, 0, 56, 543, 0, 0, 0,
+  0, 0, 328, 0, 175, 0, 914, 471, 0, 1134, 950, 896, 1067, 0, 1137, 0,
+  0, 626, 295, 1162, 0, 0, 0, 0, 103, 684, 969, 908, 1009, 841, 0, 0,
+  0, 0, 35, 520, 0, 1128, 0, 691, 1145, 546, 0, 0, 0, 237, 238, 0,
+  0, 0, 0, 522, 721, 0, 0, 73, 0, 0, 0, 814, 364, 0, 0, 1058,
+  411, 777, 254, 336, 0, 0, 0, 0, 641, 0, 792, 111, 0, 587, 0, 282,
+  0, 706, 0, 1079, 0, 540, 649, 427, 292, 0, 19, 1094, 0, 924, 0, 0,
+  0, 0, 0, 0, 0, 0, 815, 514, 0, 468, 0, 387, 0, 168, 1136, 888,
+  0, 363, 0, 0, 779, 0, 0, 874, 200, 0, 0, 0, 0, 0, 0, 0,
+  431, 671, 1, 90, 0, 0, 0, 17, 947, 78, 31, 1183, 0, 0, 639, 273,
+  0, 0, 392, 0, 0, 1032, 766, 1096, 798, 366, 592, 0, 277, 391, 1042, 0,
+  0, 759, 0, 0, 0, 74, 0, 258, 0, 740, 0, 447, 0, 1116, 810, 0,
+};
 #endif
 
 /**
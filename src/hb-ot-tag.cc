@@ -249,6 +249,31 @@ struct LangTag
 
 #include "hb-ot-tag-table.hh"
 
+/* Looks @language up in the perfect hash generated alongside
+ * @ot_languages.  Returns the index + 1 of its first row, or 0 if
+ * it is not in there. */
+template <unsigned seed_count, unsigned slot_count>
+static inline unsigned
+ot_languages_lookup (hb_tag_t language,
+		     hb_array_t<const LangTag> ot_languages,
+		     const uint8_t (&seeds)[seed_count],
+		     const uint16_t (&slots)[slot_count])
+{
+  static_assert (!(seed_count & (seed_count - 1)) && !(slot_count & (slot_count - 1)), "");
+  const unsigned seed_shift = 33 - hb_bit_storage (seed_count);
+  const unsigned slot_shift = 33 - hb_bit_storage (slot_count);
+
+  uint32_t h = language * 0x9E3779B1u;
+  h ^= h >> 15;
+  unsigned seed = seeds[h >> seed_shift];
+  unsigned i = slots[((h ^ seed) * 0x2C1B3C6Du) >> slot_shift];
+
+  /* Every language lands in some slot; check that it is the right one. */
+  if (i && ot_languages[i - 1].language != language)
+    return 0;
+  return i;
+}
+
 /* The corresponding languages IDs for the following IDs are unclear,
  * overlap, or are architecturally weird. Needs more research. */
 
@@ -307,41 +332,38 @@ hb_ot_tags_from_language (const char   *lang_str,
 	lang_str = s + 1;
     }
 #endif
-    const LangTag *ot_languages = nullptr;
-    unsigned ot_languages_len = 0;
     const char *dash = strchr (lang_str, '-');
     unsigned first_len = dash ? dash - lang_str : limit - lang_str;
+    hb_tag_t lang_tag = hb_tag_from_string (lang_str, first_len);
+
+    hb_array_t<const LangTag> ot_languages;
+    unsigned tag_idx = 0;
     if (first_len == 2)
     {
-      ot_languages = ot_languages2;
-      ot_languages_len = ARRAY_LENGTH (ot_languages2);
+      ot_languages = hb_array (ot_languages2);
+      tag_idx = ot_languages_lookup (lang_tag, ot_languages,
+				     ot_languages2_hash_seeds,
+				     ot_languages2_hash_slots);
     }
 #ifndef HB_NO_LANGUAGE_LONG
     else if (first_len == 3)
     {
-      ot_languages = ot_languages3;
-      ot_languages_len = ARRAY_LENGTH (ot_languages3);
+      ot_languages = hb_array (ot_languages3);
+      tag_idx = ot_languages_lookup (lang_tag, ot_languages,
+				     ot_languages3_hash_seeds,
+				     ot_languages3_hash_slots);
     }
 #endif
 
-    hb_tag_t lang_tag = hb_tag_from_string (lang_str, first_len);
-
-    static hb_atomic_int_t last_tag_idx; /* Poor man's cache. */
-    unsigned tag_idx = last_tag_idx;
-
-    if (likely (tag_idx < ot_languages_len && ot_languages[tag_idx].language == lang_tag) ||
-	hb_sorted_array (ot_languages, ot_languages_len).bfind (lang_tag, &tag_idx))
+    if (tag_idx)
     {
-      last_tag_idx = tag_idx;
+      tag_idx--;
       unsigned int i;
-      while (tag_idx != 0 &&
-	     ot_languages[tag_idx].language == ot_languages[tag_idx - 1].language)
-	tag_idx--;
       for (i = 0;
 	   i < *count &&
-	   tag_idx + i < ot_languages_len &&
+	   tag_idx + i < ot_languages.length &&
 	   ot_languages[tag_idx + i].tag != HB_TAG_NONE &&
-	   ot_languages[tag_idx + i].language == ot_languages[tag_idx].language;
+	   ot_languages[tag_idx + i].language == lang_tag;
 	   i++)
 	tags[i] = ot_languages[tag_idx + i].tag;
       *count = i;
@@ -645,10 +667,44 @@ test_langs_sorted ()
 #endif
 }
 
+template <unsigned seed_count, unsigned slot_count>
+static inline void
+test_langs_hashed (const char *name,
+		   hb_array_t<const LangTag> ot_languages,
+		   const uint8_t (&seeds)[seed_count],
+		   const uint16_t (&slots)[slot_count])
+{
+  for (unsigned int i = 0; i < ot_languages.length; i++)
+  {
+    unsigned first = i;
+    while (first && ot_languages[first - 1].language == ot_languages[i].language)
+      first--;
+    unsigned found = ot_languages_lookup (ot_languages[i].language, ot_languages, seeds, slots);
+    if (found != first + 1)
+    {
+      fprintf (stderr, "%s hash finds %u for index %u: %08x\n",
+	       name, found, i, ot_languages[i].language);
+      abort();
+    }
+  }
+  if (ot_languages_lookup (HB_TAG ('q','q',' ',' '), ot_languages, seeds, slots) ||
+      ot_languages_lookup (HB_TAG ('q','q','q',' '), ot_languages, seeds, slots))
+  {
+    fprintf (stderr, "%s hash finds a missing language\n", name);
+    abort();
+  }
+}
+
 int
 main ()
 {
   test_langs_sorted ();
+  test_langs_hashed ("ot_languages2", hb_array (ot_languages2),
+		     ot_languages2_hash_seeds, ot_languages2_hash_slots);
+#ifndef HB_NO_LANGUAGE_LONG
+  test_langs_hashed ("ot_languages3", hb_array (ot_languages3),
+		     ot_languages3_hash_seeds, ot_languages3_hash_slots);
+#endif
   return 0;
 }
 
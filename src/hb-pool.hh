@@ -67,9 +67,8 @@ struct hb_pool_t
     T* obj = next;
     next = * ((T**) next);
 
-    hb_memset (obj, 0, sizeof (T));
-
-    return obj;
+    /* Zero-initializes, then runs member initializers. */
+    return new (obj) T ();
   }
 
   void release (T* obj)
@@ -23,7 +23,6 @@
  *
  * Google Author(s): Garret Rieger
  */
-
 #ifndef HB_PRIORITY_QUEUE_HH
 #define HB_PRIORITY_QUEUE_HH
 
@@ -33,32 +32,72 @@
 /*
  * hb_priority_queue_t
  *
- * Priority queue implemented as a binary heap. Supports extract minimum
+ * Priority queue implemented as a 4-ary heap. Supports extract minimum
  * and insert operations.
  *
- * The priority queue is implemented as a binary heap, which is a complete
- * binary tree. The root of the tree is the minimum element. The heap
+ * The heap is a complete tree in which every node has up to four
+ * children. The root of the tree is the minimum element. The heap
  * property is that the priority of a node is less than or equal to the
  * priority of its children. The heap is stored in an array, with the
- * children of node i stored at indices 2i + 1 and 2i + 2.
+ * children of node i stored at indices 4i + 1 through 4i + 4.
+ *
+ * Compared to a binary heap the tree is half as deep, and the children
+ * of a node are adjacent in memory, so the extra comparisons made when
+ * sifting down mostly hit the same cache line.
+ *
+ * hb_indexed_priority_queue_t additionally tracks where each value sits
+ * in the heap, which allows decreasing the priority of a value that is
+ * already queued. Values are used as indices into that table, so they
+ * should be small integers (eg. object indices).
  */
-struct hb_priority_queue_t
+template <bool indexed>
+struct hb_priority_queue_base_t
 {
  private:
   typedef hb_pair_t<int64_t, unsigned> item_t;
   hb_vector_t<item_t> heap;
+  /* Position in heap plus one, or zero if not queued; indexed only. */
+  hb_vector_t<unsigned> positions;
 
  public:
 
-  void reset () { heap.resize (0); }
+  void reset ()
+  {
+    heap.resize (0);
+    positions.resize (0);
+  }
 
-  bool in_error () const { return heap.in_error (); }
+  bool in_error () const { return heap.in_error () || positions.in_error (); }
 
   void insert (int64_t priority, unsigned value)
   {
     heap.push (item_t (priority, value));
     if (unlikely (heap.in_error ())) return;
-    bubble_up (heap.length - 1);
+    if (indexed && unlikely (!ensure_position (value))) return;
+    sift_up (heap.length - 1);
+  }
+
+  /* Queues value with priority if it isn't queued yet; otherwise lowers
+   * its priority to priority, if that's lower than the current one. */
+  void decrease_priority (int64_t priority, unsigned value)
+  {
+    static_assert (indexed, "");
+    if (value >= positions.length || !positions.arrayZ[value])
+    {
+      insert (priority, value);
+      return;
+    }
+
+    unsigned index = positions.arrayZ[value] - 1;
+    if (priority >= heap.arrayZ[index].first) return;
+    heap.arrayZ[index].first = priority;
+    sift_up (index);
+  }
+
+  bool has (unsigned value) const
+  {
+    static_assert (indexed, "");
+    return value < positions.length && positions.arrayZ[value];
   }
 
   item_t pop_minimum ()
@@ -66,12 +105,13 @@ struct hb_priority_queue_t
     assert (!is_empty ());
 
     item_t result = heap.arrayZ[0];
+    if (indexed) positions.arrayZ[result.second] = 0;
 
     heap.arrayZ[0] = heap.arrayZ[heap.length - 1];
     heap.resize (heap.length - 1);
 
     if (!is_empty ())
-      bubble_down (0);
+      sift_down (0);
 
     return result;
   }
@@ -86,74 +126,81 @@ struct hb_priority_queue_t
   unsigned int get_population () const { return heap.length; }
 
   /* Sink interface. */
-  hb_priority_queue_t& operator << (item_t item)
+  hb_priority_queue_base_t& operator << (item_t item)
   { insert (item.first, item.second); return *this; }
 
  private:
 
   static constexpr unsigned parent (unsigned index)
   {
-    return (index - 1) / 2;
+    return (index - 1) / 4;
+  }
+
+  static constexpr unsigned first_child (unsigned index)
+  {
+    return 4 * index + 1;
   }
 
-  static constexpr unsigned left_child (unsigned index)
+  bool ensure_position (unsigned value)
   {
-    return 2 * index + 1;
+    if (value < positions.length) return true;
+    if (likely (positions.resize (value + 1))) return true;
+    /* Leave the heap consistent; the queue is in error now anyway. */
+    heap.pop ();
+    return false;
   }
 
-  static constexpr unsigned right_child (unsigned index)
+  /* Stores item at index.  The sifts below move items along the path
+   * and write the sifted item once at the end, instead of swapping. */
+  void place (unsigned index, const item_t &item)
   {
-    return 2 * index + 2;
+    heap.arrayZ[index] = item;
+    if (indexed) positions.arrayZ[item.second] = index + 1;
   }
 
-  void bubble_down (unsigned index)
+  void sift_down (unsigned index)
   {
     assert (index < heap.length);
 
-    unsigned left = left_child (index);
-    unsigned right = right_child (index);
+    item_t item = heap.arrayZ[index];
+    unsigned length = heap.length;
+    while (true)
+    {
+      unsigned child = first_child (index);
+      if (child >= length) break;
 
-    bool has_left = left < heap.length;
-    if (!has_left)
-      // If there's no left, then there's also no right.
-      return;
+      unsigned end = hb_min (child + 4, length);
+      unsigned min_child = child;
+      for (child++; child < end; child++)
+        if (heap.arrayZ[child].first < heap.arrayZ[min_child].first)
+          min_child = child;
 
-    bool has_right = right < heap.length;
-    if (heap.arrayZ[index].first <= heap.arrayZ[left].first
-        && (!has_right || heap.arrayZ[index].first <= heap.arrayZ[right].first))
-      return;
+      if (item.first <= heap.arrayZ[min_child].first) break;
 
-    if (!has_right || heap.arrayZ[left].first < heap.arrayZ[right].first)
-    {
-      swap (index, left);
-      bubble_down (left);
-      return;
+      place (index, heap.arrayZ[min_child]);
+      index = min_child;
     }
-
-    swap (index, right);
-    bubble_down (right);
+    place (index, item);
   }
 
-  void bubble_up (unsigned index)
+  void sift_up (unsigned index)
   {
     assert (index < heap.length);
 
-    if (index == 0) return;
-
-    unsigned parent_index = parent (index);
-    if (heap.arrayZ[parent_index].first <= heap.arrayZ[index].first)
-      return;
-
-    swap (index, parent_index);
-    bubble_up (parent_index);
-  }
+    item_t item = heap.arrayZ[index];
+    while (index)
+    {
+      unsigned parent_index = parent (index);
+      if (heap.arrayZ[parent_index].first <= item.first) break;
 
-  void swap (unsigned a, unsigned b)
-  {
-    assert (a < heap.length);
-    assert (b < heap.length);
-    hb_swap (heap.arrayZ[a], heap.arrayZ[b]);
+      place (index, heap.arrayZ[parent_index]);
+      index = parent_index;
+    }
+    place (index, item);
   }
 };
 
+typedef hb_priority_queue_base_t<false> hb_priority_queue_t;
+typedef hb_priority_queue_base_t<true> hb_indexed_priority_queue_t;
+
 #endif /* HB_PRIORITY_QUEUE_HH */
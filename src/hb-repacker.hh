@@ -343,7 +343,7 @@ hb_resolve_graph_overflows (hb_tag_t table_tag,
       }
     }
 
-    sorted_graph.sort_shortest_distance ();
+    sorted_graph.sort_shortest_distance_incremental ();
   }
 
   if (sorted_graph.in_error ())
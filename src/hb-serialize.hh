@@ -151,7 +151,10 @@ struct hb_serialize_context_t
 
     char *head;
     char *tail;
-    hb_vector_t<link_t> real_links;
+    /* While under construction, tail_length () when pushed. */
+    unsigned pushed_tail_length;
+    /* Most objects link to only a few others. */
+    hb_small_vector_t<link_t, 2> real_links;
     hb_vector_t<link_t> virtual_links;
     object_t *next;
 
@@ -164,7 +167,7 @@ struct hb_serialize_context_t
   struct snapshot_t
   {
     char *head;
-    char *tail;
+    unsigned tail_length;
     object_t *current; // Just for sanity check
     unsigned num_real_links;
     unsigned num_virtual_links;
@@ -173,7 +176,7 @@ struct hb_serialize_context_t
 
   snapshot_t snapshot ()
   { return snapshot_t {
-      head, tail, current, current->real_links.length, current->virtual_links.length, errors }; }
+      head, tail_length (), current, current->real_links.length, current->virtual_links.length, errors }; }
 
   hb_serialize_context_t (void *start_, unsigned int size) :
     start ((char *) start_),
@@ -187,6 +190,7 @@ struct hb_serialize_context_t
     for (object_t *_ : ++hb_iter (packed)) _->fini ();
     packed.fini ();
     this->packed_map.fini ();
+    spilled.fini ();
 
     while (current)
     {
@@ -225,6 +229,8 @@ struct hb_serialize_context_t
     this->tail = this->end;
     this->zerocopy = nullptr;
     this->debug_depth = 0;
+    this->spilled_length = 0;
+    this->spilled_objects = 0;
 
     fini ();
     this->packed.push (nullptr);
@@ -299,6 +305,9 @@ struct hb_serialize_context_t
 
     pop_pack (false);
 
+    if (spilled_objects)
+      join_spilled ();
+
     resolve_links ();
   }
 
@@ -314,6 +323,7 @@ struct hb_serialize_context_t
     {
       obj->head = head;
       obj->tail = tail;
+      obj->pushed_tail_length = tail_length ();
       obj->next = current;
       current = obj;
     }
@@ -326,7 +336,7 @@ struct hb_serialize_context_t
     if (unlikely (in_error() && !only_overflow ())) return;
 
     current = current->next;
-    revert (zerocopy ? zerocopy : obj->head, obj->tail);
+    revert (zerocopy ? zerocopy : obj->head, obj->pushed_tail_length);
     zerocopy = nullptr;
     obj->fini ();
     object_pool.release (obj);
@@ -408,35 +418,49 @@ struct hb_serialize_context_t
     current->real_links.shrink (snap.num_real_links);
     current->virtual_links.shrink (snap.num_virtual_links);
     errors = snap.errors;
-    revert (snap.head, snap.tail);
+    revert (snap.head, snap.tail_length);
   }
 
   void revert (char *snap_head,
-	       char *snap_tail)
+	       unsigned snap_tail_length)
   {
     if (unlikely (in_error ())) return;
     assert (snap_head <= head);
-    assert (tail <= snap_tail);
+    assert (snap_tail_length <= tail_length ());
     head = snap_head;
-    tail = snap_tail;
-    discard_stale_objects ();
+    discard_stale_objects (snap_tail_length);
   }
 
-  void discard_stale_objects ()
+  /* Discards objects packed since tail_length () was @snap_tail_length. */
+  void discard_stale_objects (unsigned snap_tail_length)
   {
     if (unlikely (in_error ())) return;
-    while (packed.length > 1 &&
-	   packed.tail ()->head < tail)
+    while (tail_length () > snap_tail_length)
     {
-      packed_map.del (packed.tail ());
-      assert (!packed.tail ()->next);
-      packed.tail ()->fini ();
+      assert (packed.length > 1);
+      object_t *obj = packed.tail ();
+      unsigned len = obj->tail - obj->head;
+      if (packed.length - 1 > spilled_objects)
+      {
+	assert (obj->head == tail);
+	tail += len;
+      }
+      else
+      {
+	spilled_length -= len;
+	spilled_objects--;
+      }
+      packed_map.del (obj);
+      assert (!obj->next);
+      obj->fini ();
       packed.pop ();
     }
-    if (packed.length > 1)
-      assert (packed.tail ()->head == tail);
   }
 
+  /* Bytes of packed objects, including those spilled. */
+  unsigned tail_length () const
+  { return spilled_length + (this->end - this->tail); }
+
   // Adds a virtual link from the current object to objidx. A virtual link is not associated with
   // an actual offset field. They are solely used to enforce ordering constraints between objects.
   // Adding a virtual link from object a to object b will ensure that object b is always packed after
@@ -582,7 +606,7 @@ struct hb_serialize_context_t
   {
     if (unlikely (in_error ())) return false;
 
-    if (unlikely (size > INT_MAX || this->tail - this->head < ptrdiff_t (size)))
+    if (unlikely (size > INT_MAX || !has_room (size)))
     {
       err (HB_SERIALIZE_ERROR_OUT_OF_ROOM);
       return false;
@@ -601,7 +625,7 @@ struct hb_serialize_context_t
   {
     if (unlikely (in_error ())) return nullptr;
 
-    if (unlikely (size > INT_MAX || this->tail - this->head < ptrdiff_t (size)))
+    if (unlikely (size > INT_MAX || !has_room (size)))
     {
       err (HB_SERIALIZE_ERROR_OUT_OF_ROOM);
       return nullptr;
@@ -738,13 +762,87 @@ struct hb_serialize_context_t
     check_assign (off, offset, HB_SERIALIZE_ERROR_OFFSET_OVERFLOW);
   }
 
+  bool has_room (size_t size)
+  {
+    if (likely (this->tail - this->head >= ptrdiff_t (size)))
+      return true;
+    return spill () && this->tail - this->head >= ptrdiff_t (size);
+  }
+
+  /* In segmented mode, running out of room moves the packed objects out
+   * of the buffer into a separately allocated segment, instead of failing.
+   * Only objects under construction need to fit in the buffer then; the
+   * segments are joined back together once serialization ends. */
+  bool spill ()
+  {
+    if (!segmented || zerocopy || this->tail == this->end)
+      return false;
+
+    hb_vector_t<char> *segment = spilled.push ();
+    if (unlikely (spilled.in_error () ||
+		  !segment->resize (this->end - this->tail, false, true)))
+      return false;
+    hb_memcpy (segment->arrayZ, this->tail, segment->length);
+
+    for (unsigned i = spilled_objects + 1; i < packed.length; i++)
+    {
+      object_t *obj = packed.arrayZ[i];
+      unsigned len = obj->tail - obj->head;
+      obj->head = segment->arrayZ + (obj->head - this->tail);
+      obj->tail = obj->head + len;
+    }
+
+    spilled_length += segment->length;
+    spilled_objects = packed.length - 1;
+    this->tail = this->end;
+    return true;
+  }
+
+  /* Moves all packed objects into one buffer, in the order they would be
+   * in had nothing been spilled. */
+  void join_spilled ()
+  {
+    assert (!current && this->head == this->start);
+    unsigned len = tail_length ();
+    if (unlikely (!joined.resize (len, false, true)))
+    {
+      err (HB_SERIALIZE_ERROR_OTHER);
+      return;
+    }
+
+    char *p = joined.arrayZ;
+    for (unsigned i = packed.length - 1; i; i--)
+    {
+      object_t *obj = packed.arrayZ[i];
+      unsigned obj_len = obj->tail - obj->head;
+      hb_memcpy (p, obj->head, obj_len);
+      obj->head = p;
+      obj->tail = p + obj_len;
+      p += obj_len;
+    }
+
+    spilled.fini ();
+    spilled_length = spilled_objects = 0;
+    this->start = this->head = this->tail = joined.arrayZ;
+    this->end = this->start + len;
+  }
+
   public:
   char *start, *head, *tail, *end, *zerocopy;
   unsigned int debug_depth;
   hb_serialize_error_t errors;
+  /* Whether to spill () packed objects when running out of room. */
+  bool segmented = false;
 
   private:
 
+  /* Segments holding spilled objects, and the buffer they are joined into. */
+  hb_vector_t<hb_vector_t<char>> spilled;
+  hb_vector_t<char> joined;
+  unsigned spilled_length;
+  /* Number of packed objects, from the first one, that were spilled. */
+  unsigned spilled_objects;
+
   void merge_virtual_links (const object_t* from, objidx_t to_idx) {
     object_t* to = packed[to_idx];
     for (const auto& l : from->virtual_links) {
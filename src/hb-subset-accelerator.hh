@@ -88,6 +88,7 @@ struct hb_subset_accelerator_t
     unicodes(unicodes_),
     cmap_cache(nullptr),
     destroy_cmap_cache(nullptr),
+    glyf_trimmed(true),
     has_seac(has_seac_),
     cff_accelerator(nullptr),
     destroy_cff_accelerator(nullptr) {}
@@ -106,6 +107,19 @@ struct hb_subset_accelerator_t
   mutable hb_mutex_t sanitized_table_cache_lock;
   mutable hb_hashmap_t<hb_tag_t, hb::unique_ptr<hb_blob_t>> sanitized_table_cache;
 
+  // GSUB
+  // Closures computed by earlier plans, oldest first.  The GSUB closure of
+  // any glyph set that contains input and is contained in output is output.
+  struct gsub_closure_t
+  {
+    hb_set_t lookups;
+    hb_set_t input;
+    hb_set_t output;
+  };
+  static constexpr unsigned MAX_GSUB_CLOSURES = 8;
+  mutable hb_mutex_t gsub_closure_cache_lock;
+  mutable hb_vector_t<gsub_closure_t> gsub_closure_cache;
+
   const hb_map_t unicode_to_gid;
   const hb_multimap_t gid_to_unicodes;
   const hb_set_t unicodes;
@@ -114,6 +128,11 @@ struct hb_subset_accelerator_t
   const OT::SubtableUnicodesCache* cmap_cache;
   hb_destroy_func_t destroy_cmap_cache;
 
+  // glyf
+  // Whether the face's glyphs have already had their padding trimmed,
+  // as hb_subset_preprocess() does.
+  bool glyf_trimmed;
+
   // CFF
   bool has_seac;
   const CFF::cff_subset_accelerator_t* cff_accelerator;
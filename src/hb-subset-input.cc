@@ -551,6 +551,72 @@ hb_subset_input_old_to_new_glyph_mapping (hb_subset_input_t *input)
   return &input->glyph_map;
 }
 
+/**
+ * hb_subset_input_set_num_threads:
+ * @input: a #hb_subset_input_t object.
+ * @num_threads: the maximum number of threads to use.
+ *
+ * Sets the number of threads the subsetter may use.  When greater than
+ * one, tables that do not depend on each other (for example `glyf`,
+ * `CFF `, `GSUB`, `GPOS` and `name`) are subset concurrently, each into
+ * its own buffer.  Tables that depend on the result of another table,
+ * such as `hmtx` on `glyf` while instancing, still wait for it.
+ *
+ * The default is one, which subsets the tables one at a time.  Threads
+ * are only available on platforms with pthreads; elsewhere this setting
+ * is ignored.  A user executor set with hb_subset_input_set_executor()
+ * takes precedence over this setting.
+ *
+ * Since: REPLACEME
+ **/
+void
+hb_subset_input_set_num_threads (hb_subset_input_t *input,
+				 unsigned int       num_threads)
+{
+  input->num_threads = hb_max (num_threads, 1u);
+}
+
+/**
+ * hb_subset_input_get_num_threads:
+ * @input: a #hb_subset_input_t object.
+ *
+ * Fetches the number of threads the subsetter may use.
+ *
+ * Return value: the number of threads set with
+ * hb_subset_input_set_num_threads().
+ *
+ * Since: REPLACEME
+ **/
+unsigned int
+hb_subset_input_get_num_threads (const hb_subset_input_t *input)
+{
+  return input->num_threads;
+}
+
+/**
+ * hb_subset_input_set_executor:
+ * @input: a #hb_subset_input_t object.
+ * @func: (nullable): the executor to use, or `NULL` to unset.
+ * @user_data: data to pass to @func.
+ *
+ * Sets a function the subsetter hands each batch of independent table
+ * subsetting tasks to, so they can be run on the caller's own thread
+ * pool.  See #hb_subset_executor_func_t.
+ *
+ * Plans created from @input keep a copy of @func and @user_data;
+ * @user_data must stay valid until those plans have been executed.
+ *
+ * Since: REPLACEME
+ **/
+void
+hb_subset_input_set_executor (hb_subset_input_t         *input,
+			      hb_subset_executor_func_t  func,
+			      void                      *user_data)
+{
+  input->executor = func;
+  input->executor_data = func ? user_data : nullptr;
+}
+
 #ifdef HB_EXPERIMENTAL_API
 /**
  * hb_subset_input_override_name_table:
@@ -118,6 +118,12 @@ struct hb_subset_input_t
   // If set loca format will always be the long version.
   bool force_long_loca = false;
 
+  // Tables that are ready to be subset run on up to this many threads,
+  // or through the user's executor if one is set.
+  unsigned num_threads = 1;
+  hb_subset_executor_func_t executor = nullptr;
+  void *executor_data = nullptr;
+
   hb_hashmap_t<hb_tag_t, float> axes_location;
   hb_map_t glyph_map;
 #ifdef HB_EXPERIMENTAL_API
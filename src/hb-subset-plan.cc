@@ -275,9 +275,63 @@ _GSUBGPOS_find_duplicate_features (const OT::GSUBGPOS &g,
   }
 }
 
+/* Closes @glyphs over @lookups.  @closed, if set, is a closure over the
+ * same lookups that @glyphs already contains. */
+static void
+_gsub_closure (hb_subset_plan_t *plan,
+	       const hb_set_t   *lookups,
+	       const hb_set_t   *closed,
+	       hb_set_t         *glyphs)
+{
+  // Nothing was added to a closed set.
+  if (closed && glyphs->is_subset (*closed))
+    return;
+
+  const hb_subset_accelerator_t *accel = plan->accelerator;
+  if (!accel)
+  {
+    hb_ot_layout_lookups_substitute_closure (plan->source, lookups, glyphs);
+    return;
+  }
+
+  // Any set between the input and the output of a closure closes to the
+  // same output, so repeated and overlapping subsets of a preprocessed face
+  // can skip the closure altogether.
+  hb_set_t input = *glyphs;
+  accel->gsub_closure_cache_lock.lock ();
+  for (const auto &entry : accel->gsub_closure_cache)
+    if (entry.lookups == *lookups &&
+	entry.input.is_subset (input) &&
+	input.is_subset (entry.output))
+    {
+      glyphs->set (entry.output);
+      accel->gsub_closure_cache_lock.unlock ();
+      return;
+    }
+  accel->gsub_closure_cache_lock.unlock ();
+
+  hb_ot_layout_lookups_substitute_closure (plan->source, lookups, glyphs);
+  if (unlikely (glyphs->in_error ()))
+    return;
+
+  accel->gsub_closure_cache_lock.lock ();
+  auto &cache = accel->gsub_closure_cache;
+  if (cache.length == hb_subset_accelerator_t::MAX_GSUB_CLOSURES)
+    cache.remove_ordered (0);
+  hb_subset_accelerator_t::gsub_closure_t *entry = cache.push ();
+  if (likely (entry != &Crap (hb_subset_accelerator_t::gsub_closure_t)))
+  {
+    entry->lookups.set (*lookups);
+    entry->input = std::move (input);
+    entry->output.set (*glyphs);
+  }
+  accel->gsub_closure_cache_lock.unlock ();
+}
+
 template <typename T>
 static inline void
 _closure_glyphs_lookups_features (hb_subset_plan_t   *plan,
+				  const hb_set_t     *closed,
 				  hb_set_t	     *gids_to_retain,
 				  hb_map_t	     *lookups,
 				  hb_map_t	     *features,
@@ -296,9 +350,7 @@ _closure_glyphs_lookups_features (hb_subset_plan_t   *plan,
                               feature_substitutes_map);
 
   if (table_tag == HB_OT_TAG_GSUB && !(plan->flags & HB_SUBSET_FLAGS_NO_LAYOUT_CLOSURE))
-    hb_ot_layout_lookups_substitute_closure (plan->source,
-                                             &lookup_indices,
-					     gids_to_retain);
+    _gsub_closure (plan, &lookup_indices, closed, gids_to_retain);
   table->closure_lookups (plan->source,
 			  gids_to_retain,
                           &lookup_indices);
@@ -421,8 +473,7 @@ _cmap_closure (hb_face_t	   *face,
 	       const hb_set_t	   *unicodes,
 	       hb_set_t		   *glyphset)
 {
-  OT::cmap::accelerator_t cmap (face);
-  cmap.table->closure_glyphs (unicodes, glyphset);
+  face->table.cmap->table->closure_glyphs (unicodes, glyphset);
 }
 
 static void _colr_closure (hb_face_t *face,
@@ -470,9 +521,15 @@ _remove_invalid_gids (hb_set_t *glyphs,
 static void
 _populate_unicodes_to_retain (const hb_set_t *unicodes,
                               const hb_set_t *glyphs,
-                              hb_subset_plan_t *plan)
+                              hb_subset_plan_t *plan,
+                              const hb_subset_plan_t *base)
 {
-  OT::cmap::accelerator_t cmap (plan->source);
+  /* Use the face's accelerators rather than building our own, so that
+   * repeated subsetting of the same face only pays for them once. */
+  const OT::cmap_accelerator_t &cmap = *plan->source->table.cmap;
+  if (base)
+    *plan->codepoint_to_glyph = *base->codepoint_to_glyph;
+
   unsigned size_threshold = plan->source->get_num_glyphs ();
   if (glyphs->is_empty () && unicodes->get_population () < size_threshold)
   {
@@ -590,6 +647,27 @@ _populate_unicodes_to_retain (const hb_set_t *unicodes,
   }
 
   auto &arr = plan->unicode_to_new_gid_list;
+  if (base)
+  {
+    // Only what was added on top of base was looked up above; merge in
+    // what base retained, which maps to the same glyphs as before.
+    hb_sorted_vector_t<hb_pair_t<hb_codepoint_t, hb_codepoint_t>> added;
+    hb_swap (added, arr);
+    arr.alloc (added.length + base->unicodes.get_population ());
+    unsigned i = 0;
+    for (hb_codepoint_t cp : base->unicodes)
+    {
+      while (i < added.length && added.arrayZ[i].first < cp)
+	arr.push (added.arrayZ[i++]);
+      // The cmap scan can pick up a codepoint of base again, through a
+      // newly requested glyph.
+      if (i < added.length && added.arrayZ[i].first == cp)
+	i++;
+      arr.push (hb_pair (cp, base->codepoint_to_glyph->get (cp)));
+    }
+    for (; i < added.length; i++)
+      arr.push (added.arrayZ[i]);
+  }
   if (arr.length)
   {
     plan->unicodes.add_sorted_array (&arr.arrayZ->first, arr.length, sizeof (*arr.arrayZ));
@@ -673,15 +751,21 @@ _nameid_closure (hb_subset_plan_t* plan,
 
 static void
 _populate_gids_to_retain (hb_subset_plan_t* plan,
-		          hb_set_t* drop_tables)
+		          hb_set_t* drop_tables,
+		          const hb_subset_plan_t *base)
 {
-  OT::glyf_accelerator_t glyf (plan->source);
-#ifndef HB_NO_SUBSET_CFF
-  OT::cff1::accelerator_t cff (plan->source);
-#endif
+  const OT::glyf_accelerator_t &glyf = *plan->source->table.glyf;
 
   plan->_glyphset_gsub.add (0); // Not-def
 
+  // The closures below are monotonic, so starting from what base already
+  // retained gives the same result with less work left to do.
+  if (base)
+  {
+    plan->_glyphset_gsub.union_ (base->_glyphset_gsub);
+    plan->_glyphset.union_ (base->_glyphset);
+  }
+
   _cmap_closure (plan->source, &plan->unicodes, &plan->_glyphset_gsub);
 
 #ifndef HB_NO_SUBSET_LAYOUT
@@ -689,6 +773,7 @@ _populate_gids_to_retain (hb_subset_plan_t* plan,
     // closure all glyphs/lookups/features needed for GSUB substitutions.
     _closure_glyphs_lookups_features<GSUB> (
         plan,
+        base ? &base->_glyphset_gsub : nullptr,
         &plan->_glyphset_gsub,
         &plan->gsub_lookups,
         &plan->gsub_features,
@@ -699,6 +784,7 @@ _populate_gids_to_retain (hb_subset_plan_t* plan,
   if (!drop_tables->has (HB_OT_TAG_GPOS))
     _closure_glyphs_lookups_features<GPOS> (
         plan,
+        nullptr,
         &plan->_glyphset_gsub,
         &plan->gpos_lookups,
         &plan->gpos_features,
@@ -736,11 +822,16 @@ _populate_gids_to_retain (hb_subset_plan_t* plan,
 #ifndef HB_NO_SUBSET_CFF
   if (!plan->accelerator || plan->accelerator->has_seac)
   {
-    bool has_seac = false;
+    const OT::cff1_accelerator_t &cff = *plan->source->table.cff1;
+    bool has_seac = base && base->has_seac;
     if (cff.is_valid ())
       for (hb_codepoint_t gid : cur_glyphset)
+      {
+	if (base && base->_glyphset_colred.has (gid))
+	  continue;
 	if (_add_cff_seac_components (cff, gid, &plan->_glyphset))
 	  has_seac = true;
+      }
     plan->has_seac = has_seac;
   }
 #endif
@@ -997,7 +1088,9 @@ _update_instance_metrics_map_from_cff2 (hb_subset_plan_t *plan)
 #endif
 
 hb_subset_plan_t::hb_subset_plan_t (hb_face_t *face,
-				    const hb_subset_input_t *input)
+				    const hb_subset_input_t *input,
+				    const hb_subset_accelerator_t *accel,
+				    const hb_subset_plan_t *base)
 {
   successful = true;
   flags = input->flags;
@@ -1038,23 +1131,44 @@ hb_subset_plan_t::hb_subset_plan_t (hb_face_t *face,
   }
 #endif
 
-  void* accel = hb_face_get_user_data(face, hb_subset_accelerator_t::user_data_key());
+  if (!accel)
+    accel = (const hb_subset_accelerator_t *) hb_face_get_user_data(face, hb_subset_accelerator_t::user_data_key());
 
   attach_accelerator_data = input->attach_accelerator_data;
   force_long_loca = input->force_long_loca;
+  num_threads = input->num_threads;
+  executor = input->executor;
+  executor_data = input->executor_data;
   if (accel)
-    accelerator = (hb_subset_accelerator_t*) accel;
+    accelerator = accel;
 
   if (unlikely (in_error ()))
     return;
 
+  if (base && !accelerator)
+  {
+    // Tables sanitized for base are the same tables of the same face.
+    for (auto _ : base->sanitized_table_cache.iter_ref ())
+      sanitized_table_cache.set (_.first,
+				 hb::unique_ptr<hb_blob_t> {hb_blob_reference (_.second.get ())});
+  }
+
 #ifndef HB_NO_VAR
   _normalize_axes_location (face, this);
 #endif
 
-  _populate_unicodes_to_retain (input->sets.unicodes, input->sets.glyphs, this);
+  if (base)
+  {
+    hb_set_t added_unicodes = *input->sets.unicodes;
+    hb_set_t added_glyphs = *input->sets.glyphs;
+    added_unicodes.subtract (base->unicodes);
+    added_glyphs.subtract (base->glyphs_requested);
+    _populate_unicodes_to_retain (&added_unicodes, &added_glyphs, this, base);
+  }
+  else
+    _populate_unicodes_to_retain (input->sets.unicodes, input->sets.glyphs, this, nullptr);
 
-  _populate_gids_to_retain (this, input->sets.drop_tables);
+  _populate_gids_to_retain (this, input->sets.drop_tables, base);
   if (unlikely (in_error ()))
     return;
 
@@ -1147,6 +1261,96 @@ hb_subset_plan_create_or_fail (hb_face_t	 *face,
   return plan;
 }
 
+/**
+ * hb_subset_plan_extend_or_fail:
+ * @plan: a subsetting plan.
+ * @unicodes: (nullable): codepoints to retain in addition to those of @plan.
+ * @glyphs: (nullable): glyph ids to retain in addition to those of @plan.
+ *
+ * Computes a plan for the face of @plan that retains everything @plan
+ * retains plus @unicodes and @glyphs, with the same options as @plan.
+ * This is meant for progressively enriching a font: every glyph that
+ * @plan retains keeps its new glyph id in the returned plan, and newly
+ * retained glyphs are numbered after them.
+ *
+ * Extending a plan is cheaper than creating a new one from scratch: only
+ * the added codepoints are looked up in cmap, glyph closures start from
+ * the glyphs @plan already retains, and tables @plan already sanitized
+ * are shared.
+ *
+ * Return value: (transfer full): New subset plan. Destroy with
+ * hb_subset_plan_destroy(). If there is a failure creating the plan
+ * nullptr will be returned.
+ *
+ * Since: REPLACEME
+ **/
+hb_subset_plan_t *
+hb_subset_plan_extend_or_fail (const hb_subset_plan_t *plan,
+			       const hb_set_t         *unicodes,
+			       const hb_set_t         *glyphs)
+{
+  hb_subset_input_t *input = hb_subset_input_create_or_fail ();
+  if (unlikely (!input))
+    return nullptr;
+
+  input->flags = plan->flags;
+  input->attach_accelerator_data = plan->attach_accelerator_data;
+  input->force_long_loca = plan->force_long_loca;
+  input->num_threads = plan->num_threads;
+  input->executor = plan->executor;
+  input->executor_data = plan->executor_data;
+  input->axes_location = plan->user_axes_location;
+
+  *input->sets.unicodes = plan->unicodes;
+  *input->sets.glyphs = plan->glyphs_requested;
+  if (unicodes) input->sets.unicodes->union_ (*unicodes);
+  if (glyphs) input->sets.glyphs->union_ (*glyphs);
+  *input->sets.name_ids = plan->name_ids;
+  *input->sets.name_languages = plan->name_languages;
+  *input->sets.layout_features = plan->layout_features;
+  *input->sets.layout_scripts = plan->layout_scripts;
+  *input->sets.drop_tables = plan->drop_tables;
+  *input->sets.no_subset_tables = plan->no_subset_tables;
+
+  // Pin the glyph ids of plan; the subsetter numbers the rest after them.
+  if (!(plan->flags & HB_SUBSET_FLAGS_RETAIN_GIDS))
+    input->glyph_map = *plan->glyph_map;
+
+#ifdef HB_EXPERIMENTAL_API
+  for (auto _ : plan->name_table_overrides)
+  {
+    hb_bytes_t name_bytes = _.second;
+    unsigned len = name_bytes.length;
+    char *name_str = nullptr;
+    if (len)
+    {
+      name_str = (char *) hb_malloc (len);
+      if (unlikely (!name_str))
+	break;
+      hb_memcpy (name_str, name_bytes.arrayZ, len);
+    }
+    input->name_table_overrides.set (_.first, hb_bytes_t (name_str, len));
+  }
+#endif
+
+  hb_subset_plan_t *new_plan = nullptr;
+  if (likely (!input->in_error ()))
+    new_plan = hb_object_create<hb_subset_plan_t> (plan->source, input,
+						    nullptr, plan);
+  hb_subset_input_destroy (input);
+
+  if (unlikely (!new_plan))
+    return nullptr;
+
+  if (unlikely (new_plan->in_error ()))
+  {
+    hb_subset_plan_destroy (new_plan);
+    return nullptr;
+  }
+
+  return new_plan;
+}
+
 /**
  * hb_subset_plan_destroy:
  * @plan: a #hb_subset_plan_t
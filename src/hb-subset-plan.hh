@@ -70,7 +70,9 @@ typedef struct head_maxp_info_t head_maxp_info_t;
 struct hb_subset_plan_t
 {
   HB_INTERNAL hb_subset_plan_t (hb_face_t *,
-				const hb_subset_input_t *input);
+				const hb_subset_input_t *input,
+				const hb_subset_accelerator_t *accel = nullptr,
+				const hb_subset_plan_t *base = nullptr);
 
   ~hb_subset_plan_t()
   {
@@ -96,6 +98,9 @@ struct hb_subset_plan_t
   unsigned flags;
   bool attach_accelerator_data = false;
   bool force_long_loca = false;
+  unsigned num_threads = 1;
+  hb_subset_executor_func_t executor = nullptr;
+  void *executor_data = nullptr;
 
   // The glyph subset
   hb_map_t *codepoint_to_glyph; // Needs to be heap-allocated
@@ -124,25 +129,37 @@ struct hb_subset_plan_t
   const hb_subset_accelerator_t* accelerator;
   hb_subset_accelerator_t* inprogress_accelerator;
 
+  // Guard the source table cache and the face builder when tables are
+  // subset in parallel.
+  hb_mutex_t sanitized_table_cache_lock;
+  hb_mutex_t dest_lock;
+
  public:
 
   template<typename T>
   hb_blob_ptr_t<T> source_table()
   {
-    hb_lock_t lock (accelerator ? &accelerator->sanitized_table_cache_lock : nullptr);
-
+    hb_mutex_t &lock = accelerator ? accelerator->sanitized_table_cache_lock : sanitized_table_cache_lock;
     auto *cache = accelerator ? &accelerator->sanitized_table_cache : &sanitized_table_cache;
-    if (cache
-        && !cache->in_error ()
-        && cache->has (+T::tableTag)) {
-      return hb_blob_reference (cache->get (+T::tableTag).get ());
+    {
+      hb_lock_t l (lock);
+      if (!cache->in_error ()
+	  && cache->has (+T::tableTag)) {
+	return hb_blob_reference (cache->get (+T::tableTag).get ());
+      }
     }
 
+    /* Sanitize outside the lock; tables subset in parallel may all be
+     * fetching their (expensive to sanitize) source table at once. */
     hb::unique_ptr<hb_blob_t> table_blob {hb_sanitize_context_t ().reference_table<T> (source)};
-    hb_blob_t* ret = hb_blob_reference (table_blob.get ());
 
-    if (likely (cache))
-      cache->set (+T::tableTag, std::move (table_blob));
+    hb_lock_t l (lock);
+    if (!cache->in_error ()
+	&& cache->has (+T::tableTag)) /* Lost the race. */
+      return hb_blob_reference (cache->get (+T::tableTag).get ());
+
+    hb_blob_t* ret = hb_blob_reference (table_blob.get ());
+    cache->set (+T::tableTag, std::move (table_blob));
 
     return ret;
   }
@@ -238,6 +255,7 @@ struct hb_subset_plan_t
 		hb_blob_get_length (source_blob));
       hb_blob_destroy (source_blob);
     }
+    hb_lock_t l (dest_lock);
     return hb_face_builder_add_table (dest, tag, contents);
   }
 };
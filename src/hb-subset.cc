@@ -59,6 +59,10 @@
 #include "hb-repacker.hh"
 #include "hb-subset-accelerator.hh"
 
+#if !defined(HB_NO_MT) && defined(HAVE_PTHREAD)
+#include <pthread.h>
+#endif
+
 using OT::Layout::GSUB;
 using OT::Layout::GPOS;
 
@@ -296,6 +300,9 @@ _subset (hb_subset_plan_t *plan, hb_vector_t<char> &buf)
 
   bool needed = false;
   hb_serialize_context_t serializer (buf.arrayZ, buf.allocated);
+  /* Spill packed objects rather than restart when the estimate is short;
+   * only running out of room for objects under construction restarts. */
+  serializer.segmented = true;
   {
     hb_subset_context_t c (source_blob.get_blob (), plan, &serializer, tag);
     needed = _try_subset (table, &buf, &c);
@@ -498,21 +505,118 @@ _subset_table (hb_subset_plan_t *plan,
   }
 }
 
-static void _attach_accelerator_data (hb_subset_plan_t* plan,
-                                      hb_face_t* face /* IN/OUT */)
+struct hb_subset_table_task_t
 {
-  if (!plan->inprogress_accelerator) return;
+  hb_subset_plan_t *plan;
+  hb_tag_t tag;
+  bool success;
+};
 
-  // Transfer the accelerator from the plan to us.
-  hb_subset_accelerator_t* accel = plan->inprogress_accelerator;
-  plan->inprogress_accelerator = nullptr;
+static void
+_subset_table_task (void *data)
+{
+  hb_subset_table_task_t *task = (hb_subset_table_task_t *) data;
 
-  if (accel->in_error ())
+  /* Each task serializes into its own buffer. */
+  hb_vector_t<char> buf;
+  buf.alloc (4096 - 16);
+  task->success = _subset_table (task->plan, buf, task->tag);
+}
+
+#if !defined(HB_NO_MT) && defined(HAVE_PTHREAD)
+struct hb_subset_task_queue_t
+{
+  hb_subset_task_func_t func;
+  void **tasks;
+  unsigned num_tasks;
+  hb_atomic_int_t next;
+};
+
+static void *
+_run_subset_task_queue (void *data)
+{
+  hb_subset_task_queue_t *queue = (hb_subset_task_queue_t *) data;
+  unsigned i;
+  while ((i = (unsigned) queue->next.inc ()) < queue->num_tasks)
+    queue->func (queue->tasks[i]);
+  return nullptr;
+}
+
+/* Built-in executor: the calling thread and up to num_threads - 1
+ * helpers pull tasks off a shared counter until none are left. */
+static void
+_run_subset_tasks_threaded (hb_subset_task_func_t func,
+			    void **tasks,
+			    unsigned num_tasks,
+			    unsigned num_threads)
+{
+  hb_subset_task_queue_t queue {func, tasks, num_tasks, 0};
+
+  hb_vector_t<pthread_t> threads;
+  unsigned num_helpers = hb_min (num_threads, num_tasks) - 1;
+  if (likely (threads.alloc (num_helpers)))
+    for (unsigned i = 0; i < num_helpers; i++)
+    {
+      pthread_t thread;
+      if (pthread_create (&thread, nullptr, _run_subset_task_queue, &queue))
+	break; /* The threads we have will pick up the slack. */
+      threads.push (thread);
+    }
+
+  _run_subset_task_queue (&queue);
+
+  for (pthread_t thread : threads)
+    pthread_join (thread, nullptr);
+}
+#endif
+
+static void
+_run_subset_tasks (hb_subset_task_func_t func,
+		   void **tasks,
+		   unsigned num_tasks,
+		   unsigned num_threads)
+{
+#if !defined(HB_NO_MT) && defined(HAVE_PTHREAD)
+  if (num_threads > 1)
   {
-    hb_subset_accelerator_t::destroy (accel);
+    _run_subset_tasks_threaded (func, tasks, num_tasks, num_threads);
     return;
   }
+#endif
+  for (unsigned i = 0; i < num_tasks; i++)
+    func (tasks[i]);
+}
+
+static bool
+_subset_tables_parallel (hb_subset_plan_t *plan,
+			 hb_array_t<const hb_tag_t> tags)
+{
+  hb_vector_t<hb_subset_table_task_t> tasks;
+  hb_vector_t<void *> task_ptrs;
+  if (unlikely (!tasks.resize (tags.length) ||
+		!task_ptrs.resize (tags.length)))
+    return false;
+
+  for (unsigned i = 0; i < tags.length; i++)
+  {
+    tasks[i] = {plan, tags[i], false};
+    task_ptrs[i] = &tasks[i];
+  }
 
+  if (plan->executor)
+    plan->executor (_subset_table_task, task_ptrs.arrayZ, task_ptrs.length, plan->executor_data);
+  else
+    _run_subset_tasks (_subset_table_task, task_ptrs.arrayZ, task_ptrs.length, plan->num_threads);
+
+  for (const hb_subset_table_task_t &task : tasks)
+    if (unlikely (!task.success))
+      return false;
+  return true;
+}
+
+static bool _attach_accelerator (hb_subset_accelerator_t* accel,
+                                 hb_face_t* face /* IN/OUT */)
+{
   // Populate caches that need access to the final tables.
   hb_blob_ptr_t<OT::cmap> cmap_ptr (hb_sanitize_context_t ().reference_table<OT::cmap> (face));
   accel->cmap_cache = OT::cmap::create_filled_cache (cmap_ptr);
@@ -523,7 +627,288 @@ static void _attach_accelerator_data (hb_subset_plan_t* plan,
                              accel,
                              hb_subset_accelerator_t::destroy,
                              true))
+  {
     hb_subset_accelerator_t::destroy (accel);
+    return false;
+  }
+  return true;
+}
+
+static void _attach_accelerator_data (hb_subset_plan_t* plan,
+                                      hb_face_t* face /* IN/OUT */)
+{
+  if (!plan->inprogress_accelerator) return;
+
+  // Transfer the accelerator from the plan to us.
+  hb_subset_accelerator_t* accel = plan->inprogress_accelerator;
+  plan->inprogress_accelerator = nullptr;
+
+  if (accel->in_error ())
+  {
+    hb_subset_accelerator_t::destroy (accel);
+    return;
+  }
+
+  _attach_accelerator (accel, face);
+}
+
+/*
+ * Persisted accelerator data, see hb_subset_preprocess_serialize().
+ *
+ * Only what is expensive to recompute is stored: the unicode to glyph
+ * mapping, as ranges of consecutive code points mapped to consecutive
+ * glyphs, and the flags.  The unicode set and the reverse mapping are
+ * rebuilt from the ranges on load.
+ */
+
+namespace OT {
+
+struct SubsetAcceleratorRange
+{
+  bool sanitize (hb_sanitize_context_t *c, unsigned num_glyphs) const
+  {
+    TRACE_SANITIZE (this);
+    return_trace (c->check_struct (this) &&
+		  start <= end &&
+		  end <= HB_UNICODE_MAX &&
+		  glyphID < num_glyphs &&
+		  end - start < num_glyphs - glyphID);
+  }
+
+  HBUINT32	start;		/* First code point in this range. */
+  HBUINT32	end;		/* Last code point in this range. */
+  HBUINT32	glyphID;	/* Glyph of the first code point. */
+  public:
+  DEFINE_SIZE_STATIC (12);
+};
+
+struct SubsetAcceleratorData
+{
+  enum { MAGIC = HB_TAG ('h','b','S','A') };
+
+  enum flags_t {
+    HAS_SEAC		= 0x0001u,
+    GLYF_TRIMMED	= 0x0002u,
+  };
+
+  /* Checksum of the source tables the data was derived from; computed
+   * the same way as a table directory checksum. */
+  static uint32_t table_checksum (hb_face_t *face, hb_tag_t tag)
+  {
+    hb_blob_t *blob = hb_face_reference_table (face, tag);
+    const uint8_t *data = (const uint8_t *) hb_blob_get_data (blob, nullptr);
+    unsigned len = hb_blob_get_length (blob);
+
+    uint32_t sum = CheckSum::CalcTableChecksum ((const HBUINT32 *) data, len & ~3u);
+    if (len & 3)
+    {
+      HBUINT32 tail;
+      hb_memset (&tail, 0, sizeof (tail));
+      hb_memcpy (&tail, data + (len & ~3u), len & 3);
+      sum += tail;
+    }
+
+    hb_blob_destroy (blob);
+    return sum;
+  }
+
+  bool matches (hb_face_t *face) const
+  {
+    return numGlyphs == face->get_num_glyphs () &&
+	   cmapChecksum == table_checksum (face, HB_OT_TAG_cmap) &&
+	   locaChecksum == table_checksum (face, HB_OT_TAG_loca) &&
+	   cffChecksum == table_checksum (face, HB_OT_TAG_CFF1);
+  }
+
+  bool serialize (hb_serialize_context_t *c,
+		  hb_face_t *face,
+		  const hb_subset_accelerator_t *accel)
+  {
+    TRACE_SERIALIZE (this);
+    if (unlikely (!c->extend_min (this))) return_trace (false);
+
+    magic = MAGIC;
+    version = 1;
+    flags = (accel->has_seac ? HAS_SEAC : 0) |
+	    (accel->glyf_trimmed ? GLYF_TRIMMED : 0);
+    numGlyphs = face->get_num_glyphs ();
+    cmapChecksum = table_checksum (face, HB_OT_TAG_cmap);
+    locaChecksum = table_checksum (face, HB_OT_TAG_loca);
+    cffChecksum = table_checksum (face, HB_OT_TAG_CFF1);
+
+    SubsetAcceleratorRange *range = nullptr;
+    unsigned count = 0;
+    for (hb_codepoint_t u : accel->unicodes)
+    {
+      hb_codepoint_t g = accel->unicode_to_gid.get (u);
+      if (range &&
+	  u == range->end + 1 &&
+	  g == range->glyphID + (u - range->start))
+      {
+	range->end = u;
+	continue;
+      }
+
+      range = c->allocate_size<SubsetAcceleratorRange> (SubsetAcceleratorRange::static_size);
+      if (unlikely (!range)) return_trace (false);
+      range->start = range->end = u;
+      range->glyphID = g;
+      count++;
+    }
+    ranges.len = count;
+
+    return_trace (!c->in_error ());
+  }
+
+  hb_subset_accelerator_t *create_accelerator () const
+  {
+    hb_map_t unicode_to_gid;
+    hb_set_t unicodes;
+    hb_multimap_t gid_to_unicodes;
+
+    for (const SubsetAcceleratorRange &range : ranges)
+    {
+      unicodes.add_range (range.start, range.end);
+      for (hb_codepoint_t u = range.start; u <= range.end; u++)
+      {
+	hb_codepoint_t g = range.glyphID + (u - range.start);
+	unicode_to_gid.set (u, g);
+	gid_to_unicodes.add (g, u);
+      }
+    }
+
+    hb_subset_accelerator_t *accel =
+      hb_subset_accelerator_t::create (unicode_to_gid,
+				       gid_to_unicodes,
+				       unicodes,
+				       flags & HAS_SEAC);
+    if (unlikely (!accel)) return nullptr;
+    accel->glyf_trimmed = flags & GLYF_TRIMMED;
+
+    return accel;
+  }
+
+  bool sanitize (hb_sanitize_context_t *c) const
+  {
+    TRACE_SANITIZE (this);
+    if (unlikely (!(c->check_struct (this) &&
+		    magic == MAGIC &&
+		    version == 1 &&
+		    ranges.sanitize (c, numGlyphs))))
+      return_trace (false);
+
+    /* create_accelerator () relies on the ranges being sorted and not
+     * overlapping, which also bounds their total size. */
+    for (unsigned i = 1; i < ranges.len; i++)
+      if (unlikely (ranges.arrayZ[i].start <= ranges.arrayZ[i - 1].end))
+	return_trace (false);
+
+    return_trace (true);
+  }
+
+  protected:
+  Tag		magic;		/* 'hbSA' */
+  HBUINT16	version;	/* Currently 1. */
+  HBUINT16	flags;		/* See flags_t. */
+  HBUINT32	numGlyphs;	/* Glyph count of the face. */
+  HBUINT32	cmapChecksum;	/* Checksum of the face's cmap table. */
+  HBUINT32	locaChecksum;	/* Checksum of the face's loca table, or 0;
+				 * tells trimmed glyphs from untrimmed. */
+  HBUINT32	cffChecksum;	/* Checksum of the face's CFF table, or 0. */
+  Array32Of<SubsetAcceleratorRange>
+		ranges;		/* Unicode to glyph mapping. */
+  public:
+  DEFINE_SIZE_ARRAY (28, ranges);
+};
+
+} /* namespace OT */
+
+/**
+ * hb_subset_preprocess_serialize:
+ * @face: a #hb_face_t object returned by hb_subset_preprocess().
+ *
+ * Serializes the data hb_subset_preprocess() attached to @face, so that
+ * it can be stored next to the font data of @face and attached again
+ * with hb_subset_preprocess_attach() later, without redoing the
+ * preprocessing.
+ *
+ * The returned data is position independent and can be stored in, and
+ * later used directly from, a memory-mapped file.
+ *
+ * Return value: (transfer full): the serialized data, or the empty blob
+ * if @face has not been preprocessed or allocation failed.
+ *
+ * Since: REPLACEME
+ **/
+hb_blob_t *
+hb_subset_preprocess_serialize (hb_face_t *face)
+{
+  const hb_subset_accelerator_t *accel = (const hb_subset_accelerator_t *)
+    hb_face_get_user_data (face, hb_subset_accelerator_t::user_data_key ());
+  if (!accel) return hb_blob_get_empty ();
+
+  /* Worst case is one range per code point. */
+  unsigned size = OT::SubsetAcceleratorData::min_size +
+		  accel->unicodes.get_population () * OT::SubsetAcceleratorRange::static_size;
+  char *buf = (char *) hb_malloc (size);
+  if (unlikely (!buf)) return hb_blob_get_empty ();
+
+  hb_serialize_context_t c (buf, size);
+  OT::SubsetAcceleratorData *data = c.start_serialize<OT::SubsetAcceleratorData> ();
+  bool ret = data->serialize (&c, face, accel);
+  c.end_serialize ();
+
+  if (unlikely (!ret || c.in_error ()))
+  {
+    hb_free (buf);
+    return hb_blob_get_empty ();
+  }
+
+  return hb_blob_create (buf, c.head - c.start,
+			 HB_MEMORY_MODE_WRITABLE,
+			 buf, hb_free);
+}
+
+/**
+ * hb_subset_preprocess_attach:
+ * @face: a #hb_face_t object.
+ * @data: data returned by hb_subset_preprocess_serialize().
+ *
+ * Attaches previously serialized preprocessing data to @face, making
+ * subsequent subsetting of @face as fast as subsetting the face
+ * hb_subset_preprocess() returned.  @face must be created from the
+ * font data of that face.
+ *
+ * @data is checked against checksums of the @face tables it was
+ * derived from, and rejected if it does not match.
+ *
+ * The parsed CFF charstrings that hb_subset_preprocess() also caches
+ * are not part of @data; subsetting CFF fonts works but does not
+ * benefit from them.
+ *
+ * Return value: `true` if the data was attached, `false` otherwise.
+ *
+ * Since: REPLACEME
+ **/
+hb_bool_t
+hb_subset_preprocess_attach (hb_face_t *face,
+			     hb_blob_t *data)
+{
+  hb_blob_t *sanitized = hb_sanitize_context_t ().sanitize_blob<OT::SubsetAcceleratorData> (hb_blob_reference (data));
+  const OT::SubsetAcceleratorData *table = sanitized->as<OT::SubsetAcceleratorData> ();
+
+  hb_subset_accelerator_t *accel = nullptr;
+  if (hb_blob_get_length (sanitized) && table->matches (face))
+    accel = table->create_accelerator ();
+  hb_blob_destroy (sanitized);
+
+  if (unlikely (!accel || accel->in_error ()))
+  {
+    hb_subset_accelerator_t::destroy (accel);
+    return false;
+  }
+
+  return _attach_accelerator (accel, face);
 }
 
 /**
@@ -551,6 +936,143 @@ hb_subset_or_fail (hb_face_t *source, const hb_subset_input_t *input)
   return result;
 }
 
+/*
+ * Builds the accelerator that hb_subset_preprocess() would attach, for
+ * sharing between the plans of one batch.  The CFF seac check and the
+ * cached CFF charstrings are left out: the former needs every glyph
+ * parsed, the latter only pays off for a preprocessed face.
+ */
+static hb_subset_accelerator_t *
+_create_batch_accelerator (hb_face_t *source)
+{
+  hb_set_t unicodes;
+  hb_map_t unicode_to_gid;
+  source->table.cmap->collect_mapping (&unicodes, &unicode_to_gid);
+
+  hb_multimap_t gid_to_unicodes;
+  for (hb_codepoint_t unicode : unicodes)
+    gid_to_unicodes.add (unicode_to_gid[unicode], unicode);
+
+  hb_subset_accelerator_t *accel =
+    hb_subset_accelerator_t::create (unicode_to_gid,
+				     gid_to_unicodes,
+				     unicodes,
+				     true);
+  if (unlikely (!accel)) return nullptr;
+
+  /* Unlike a preprocessed face, the source glyphs may still be padded. */
+  accel->glyf_trimmed = false;
+
+  /* Seed the sanitized table cache with the cmap blob the subtable cache
+   * points into; plans match the two up by address. */
+  hb_blob_t *cmap_blob = hb_sanitize_context_t ().reference_table<OT::cmap> (source);
+  accel->sanitized_table_cache.set (HB_OT_TAG_cmap,
+				    hb::unique_ptr<hb_blob_t> {hb_blob_reference (cmap_blob)});
+  accel->cmap_cache = OT::cmap::create_filled_cache (cmap_blob);
+  accel->destroy_cmap_cache = OT::SubtableUnicodesCache::destroy;
+
+  if (unlikely (accel->in_error () || !accel->cmap_cache))
+  {
+    hb_subset_accelerator_t::destroy (accel);
+    return nullptr;
+  }
+
+  return accel;
+}
+
+struct hb_subset_batch_task_t
+{
+  hb_face_t *source;
+  const hb_subset_input_t *input;
+  const hb_subset_accelerator_t *accel;
+  hb_face_t *result;
+};
+
+static void
+_subset_batch_task (void *data)
+{
+  hb_subset_batch_task_t *task = (hb_subset_batch_task_t *) data;
+
+  hb_subset_plan_t *plan = hb_object_create<hb_subset_plan_t> (task->source, task->input, task->accel);
+  if (unlikely (!plan)) return;
+
+  if (likely (!plan->in_error ()))
+    task->result = hb_subset_plan_execute_or_fail (plan);
+  hb_subset_plan_destroy (plan);
+}
+
+/**
+ * hb_subset_batch:
+ * @source: font face data to be subset.
+ * @count: number of inputs.
+ * @inputs: (array length=count): inputs to use for the subsetting.
+ * @subsets: (out) (array length=count): the subsets produced.
+ * @num_threads: maximum number of subsets to produce concurrently.
+ *
+ * Subsets @source once for each of @inputs, storing a reference to the
+ * result for `inputs[i]` in `subsets[i]`, or `NULL` if that subset
+ * failed.  The output is the same as calling hb_subset_or_fail() on
+ * each input in turn, but the work that only depends on @source is
+ * done once for the whole batch: the cmap mapping and subtable caches,
+ * sanitized source tables, and the face's table accelerators are
+ * shared by all the subsets.
+ *
+ * If @source was produced by hb_subset_preprocess(), its precomputed
+ * data is used instead.
+ *
+ * When @num_threads is greater than one, up to that many subsets are
+ * produced concurrently.  Threads are only available on platforms with
+ * pthreads; elsewhere the subsets are produced one at a time.
+ *
+ * Return value: `true` if every subset succeeded, `false` otherwise.
+ *
+ * Since: REPLACEME
+ **/
+hb_bool_t
+hb_subset_batch (hb_face_t          *source,
+		 unsigned int        count,
+		 hb_subset_input_t **inputs,
+		 hb_face_t         **subsets,
+		 unsigned int        num_threads)
+{
+  if (unlikely (!count)) return true;
+
+  hb_subset_accelerator_t *accel = nullptr;
+  if (count > 1 &&
+      !hb_face_get_user_data (source, hb_subset_accelerator_t::user_data_key ()))
+    accel = _create_batch_accelerator (source);
+
+  hb_vector_t<hb_subset_batch_task_t> tasks;
+  hb_vector_t<void *> task_ptrs;
+  if (unlikely (!tasks.resize (count) ||
+		!task_ptrs.resize (count)))
+  {
+    hb_subset_accelerator_t::destroy (accel);
+    for (unsigned i = 0; i < count; i++)
+      subsets[i] = nullptr;
+    return false;
+  }
+
+  for (unsigned i = 0; i < count; i++)
+  {
+    tasks[i] = {source, inputs[i], accel, nullptr};
+    task_ptrs[i] = &tasks[i];
+  }
+
+  _run_subset_tasks (_subset_batch_task, task_ptrs.arrayZ, count, num_threads);
+
+  hb_subset_accelerator_t::destroy (accel);
+
+  bool success = true;
+  for (unsigned i = 0; i < count; i++)
+  {
+    subsets[i] = tasks[i].result;
+    if (!subsets[i])
+      success = false;
+  }
+  return success;
+}
+
 
 /**
  * hb_subset_plan_execute_or_fail:
@@ -587,8 +1109,12 @@ hb_subset_plan_execute_or_fail (hb_subset_plan_t *plan)
     offset += num_tables;
   }
 
+  bool parallel = plan->executor || plan->num_threads > 1;
+  hb_vector_t<hb_tag_t> ready_tags;
+
   hb_vector_t<char> buf;
-  buf.alloc (4096 - 16);
+  if (!parallel)
+    buf.alloc (4096 - 16);
 
 
   bool success = true;
@@ -601,6 +1127,40 @@ hb_subset_plan_execute_or_fail (hb_subset_plan_t *plan)
       goto end;
     }
 
+    if (parallel)
+    {
+      /* Collect everything that is ready before removing any of it from
+       * pending, so that a table never runs alongside one it depends on. */
+      ready_tags.resize (0);
+      for (hb_tag_t tag : pending_subset_tags)
+	if (_dependencies_satisfied (plan, tag,
+				     subsetted_tags,
+				     pending_subset_tags))
+	  ready_tags.push (tag);
+
+      if (unlikely (ready_tags.in_error ()))
+      {
+	success = false;
+	goto end;
+      }
+      if (!ready_tags)
+      {
+	DEBUG_MSG (SUBSET, nullptr, "Table dependencies unable to be satisfied. Subset failed.");
+	success = false;
+	goto end;
+      }
+
+      for (hb_tag_t tag : ready_tags)
+      {
+	pending_subset_tags.del (tag);
+	subsetted_tags.add (tag);
+      }
+
+      success = _subset_tables_parallel (plan, ready_tags);
+      if (unlikely (!success)) goto end;
+      continue;
+    }
+
     bool made_changes = false;
     for (hb_tag_t tag : pending_subset_tags)
     {
@@ -175,6 +175,47 @@ hb_subset_input_pin_axis_location (hb_subset_input_t  *input,
 				   hb_tag_t            axis_tag,
 				   float               axis_value);
 
+/**
+ * hb_subset_task_func_t:
+ * @task: the task to run.
+ *
+ * A function that subsets one table.  Handed to a
+ * #hb_subset_executor_func_t together with the tasks to run.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_subset_task_func_t) (void *task);
+
+/**
+ * hb_subset_executor_func_t:
+ * @func: the function to run on each task.
+ * @tasks: (array length=num_tasks): the tasks to run.
+ * @num_tasks: the number of tasks.
+ * @user_data: user data passed to hb_subset_input_set_executor().
+ *
+ * A function that runs a batch of independent subsetting tasks, calling
+ * @func once on each element of @tasks, in any order and possibly
+ * concurrently.  It must not return before all the tasks have finished.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_subset_executor_func_t) (hb_subset_task_func_t   func,
+					   void                  **tasks,
+					   unsigned int            num_tasks,
+					   void                   *user_data);
+
+HB_EXTERN void
+hb_subset_input_set_num_threads (hb_subset_input_t *input,
+				 unsigned int       num_threads);
+
+HB_EXTERN unsigned int
+hb_subset_input_get_num_threads (const hb_subset_input_t *input);
+
+HB_EXTERN void
+hb_subset_input_set_executor (hb_subset_input_t         *input,
+			      hb_subset_executor_func_t  func,
+			      void                      *user_data);
+
 #ifdef HB_EXPERIMENTAL_API
 HB_EXTERN hb_bool_t
 hb_subset_input_override_name_table (hb_subset_input_t  *input,
@@ -190,9 +231,23 @@ hb_subset_input_override_name_table (hb_subset_input_t  *input,
 HB_EXTERN hb_face_t *
 hb_subset_preprocess (hb_face_t *source);
 
+HB_EXTERN hb_blob_t *
+hb_subset_preprocess_serialize (hb_face_t *face);
+
+HB_EXTERN hb_bool_t
+hb_subset_preprocess_attach (hb_face_t *face,
+			     hb_blob_t *data);
+
 HB_EXTERN hb_face_t *
 hb_subset_or_fail (hb_face_t *source, const hb_subset_input_t *input);
 
+HB_EXTERN hb_bool_t
+hb_subset_batch (hb_face_t          *source,
+		 unsigned int        count,
+		 hb_subset_input_t **inputs,
+		 hb_face_t         **subsets,
+		 unsigned int        num_threads);
+
 HB_EXTERN hb_face_t *
 hb_subset_plan_execute_or_fail (hb_subset_plan_t *plan);
 
@@ -200,6 +255,11 @@ HB_EXTERN hb_subset_plan_t *
 hb_subset_plan_create_or_fail (hb_face_t                 *face,
                                const hb_subset_input_t   *input);
 
+HB_EXTERN hb_subset_plan_t *
+hb_subset_plan_extend_or_fail (const hb_subset_plan_t    *plan,
+                               const hb_set_t            *unicodes,
+                               const hb_set_t            *glyphs);
+
 HB_EXTERN void
 hb_subset_plan_destroy (hb_subset_plan_t *plan);
 
@@ -1065,6 +1065,110 @@ _hb_ucd_dm2_u64_map[388] =
    HB_CODEPOINT_ENCODE3 (0x1D1BBu, 0x1D16Eu, 0x0000u), HB_CODEPOINT_ENCODE3 (0x1D1BBu, 0x1D16Fu, 0x0000u),
    HB_CODEPOINT_ENCODE3 (0x1D1BCu, 0x1D16Eu, 0x0000u), HB_CODEPOINT_ENCODE3 (0x1D1BCu, 0x1D16Fu, 0x0000u),
 };
+static const uint8_t
+_hb_ucd_dm2_hash_seed[512] =
+{
+    0,  0,  0,  1,  2,  2,  0,  1,  1,  0,  1,  2,  0,  2,  1,  0,
+    3,  4,  0, 17,  0,  7,  0,  3,  4,  0,  0,  1, 11,  4,  0,  1,
+    0,  8,  5,  0,  0,  0,  0,  4,  0,  0,  7,  7,  2,  7,  4,  0,
+    1,  3,  2,  7,  1,  8,  6,  1,  4,  1,  0, 16,  4,  0,  2,  5,
+    7, 13,  0,  1,  4,  0,  0,  0,  1,  0,  0,  4,  0,  0,  1,  0,
+    6,  0,  3,  1,  0,  0,  2,  0,  1,  1,  2,  0,  6,  0,  3,  8,
+    0,  0,  2,  9,  0,  1,  4, 22,  4,  3,  9,  0,  3,  3,  3,  1,
+    2,  1,  3,  0,  1,  4,  5,  0,  1,  2, 11,  1,  2,  0, 27,  1,
+    0,  1, 20,  4,  1,  0, 16,  2,  0,  2,  0, 17,  0,  0, 12,  1,
+    0,  1,  0,  9,  5, 17,  1,  0,  0,  0,  0,  0, 34,  3,  0,  2,
+    1,  3,  3,  0,  5,  1,  0,  0,  3,  0,  0,  3,  0,  1,  0,  5,
+   14,  0,  0,  0,  9,  0,  1, 17, 12, 25,  4,  3,  0,  4,  1, 10,
+   18,  2,  0,  0,  7,  7,  0,  0,  0,  0,  9,  0,  8,  1,  7,  0,
+    1,  9,  0, 31,  0,  2,  2,  1,  0,  6,  4,  0, 10,  7, 39, 10,
+    1,  4,  7,  4,  0,  3,  4,  0,  0,  5,  0,  3,  0,  1,  3,  0,
+    0,  7,  0,  8, 11,  4,  0,  4,  1,  3, 17,  0, 11,  0, 23,  1,
+   21,  1,  5, 15,  1,  3,  4, 24,  2, 16,  0, 38,  0, 11, 14,  5,
+   59,  0,  1,  5,  2,  0,  0, 14,  0,  0,  0,  0, 20, 27,  0,  1,
+    0,  3, 10,  3,  0,  6,  2,  0,  1,  0,  1,  0,  1,  7,  0,  0,
+    2, 14,  1,  2, 48, 24, 46,  0,  1, 38,  1,  3, 13,  2,  0, 32,
+   67,  4,  0,  0, 21,  0,  0,  9,  8,  4,  0,  0,  2,  1,  0,  0,
+    9, 11,  8,  7, 16,  2,  0, 29, 24,  2,  0,  0, 80,  1,  2,  1,
+    2,  0,  1,  6,  0,  7,  0,  0,  0,  0,  6,  5, 35,  4,  9,  0,
+    0,  9,  1,  0,  2,  0, 22,  2,  1,  1,  2,  0,  0,  2,  3,  4,
+   29,  4,  3,  9,  1,  3,  7,  0,  0,  4,  2, 27,  0, 17,  5, 20,
+    3, 10,  0,  2, 43,  0, 33, 19,  0,  0,  5,  1, 10, 15,  4,  2,
+    0,  3,  1,  2, 16, 10,  0,  0, 26,  5,  0,  0,  0,  5,  0,  1,
+   40,  1, 32,  3,  1,  3,  8,  2,  8,  6,  0,  3, 29, 31,  7,  1,
+   17,  2, 10, 18,  0,  7, 11,  0,  9, 14,  0, 18, 19,  0,  1,  7,
+   28,  6, 15,  0, 16,  3, 12,  0, 20, 20,  1, 11,  0, 47,  0, 35,
+   14, 18, 28,  8, 10,  0,  0,  0, 32, 74, 18, 46,  9, 34, 19,  2,
+   41, 11, 51,  0,  0,  0,  6,  5,  4,100,  0,  6, 13,  3,  4,  6,
+};
+static const uint16_t
+_hb_ucd_dm2_hash_map[1024] =
+{
+   745, 952, 538, 375, 754, 981, 389, 613,   0, 721, 436, 196, 746,   0, 638, 406,
+    10, 323, 443,   0, 248, 306, 912,   7,   0, 345, 364, 800,  92,  71, 899,  85,
+     0, 235, 829, 369, 454, 939, 970, 223, 561, 958,1006,   0, 632, 631, 527, 226,
+   832, 240, 208,   0, 289, 119, 861,  38, 604, 211, 781, 514, 377, 379, 161,  81,
+   351, 555, 841, 818, 383,  45, 247, 955, 941, 740, 463, 979, 835, 215,  74, 792,
+    48,   0, 134, 789, 382, 526, 304, 566,  39, 317, 615, 338, 183, 164, 932,  94,
+   344, 259,   0,  13, 491, 378, 123, 365, 875, 354, 788, 201, 551, 838, 967, 488,
+   274, 804, 934, 181,  27, 328, 994,  80, 672, 392, 935, 612,   0,   0, 966, 190,
+   521, 507,   0, 849, 194, 277,   0, 522,   0, 524, 923, 579, 200, 171,  18, 477,
+   983, 621, 173, 509, 869, 158, 216,  53,  33, 562, 897, 363,  70, 239, 843, 230,
+     0, 293, 435, 944,   0, 185, 357, 402, 504, 336, 516, 977, 906, 106, 475, 193,
+   195, 384, 157, 676, 225, 374, 282, 450, 985, 176, 611, 468, 373, 451, 764, 342,
+   322, 311, 433, 417, 108,  79, 203,  40, 368, 564, 694, 327, 428, 474, 130, 275,
+    88, 440, 427, 360, 925, 809, 882, 483, 677, 798,  23, 573, 192, 256, 847, 907,
+   819, 500, 144, 301,   0, 517, 583,   0, 968, 597, 900, 182, 419, 703, 825, 318,
+    16, 530,  35, 599, 937,1005, 198, 578, 353, 163,  97, 199, 554, 539, 748, 902,
+   862, 820, 544,  22,  28, 949, 426, 105, 628, 233, 156, 154,   0, 991, 370,   1,
+   313,  26, 998, 329, 494, 510, 883, 755, 179,  63, 928, 333, 863,  11,  20, 331,
+     0, 975, 152, 128, 531,  52, 177,  72, 543,   0, 246, 773,1009, 499,   0,  17,
+   452, 261, 446, 617, 982,   0, 850, 523, 221,  30,1003, 309, 886, 927, 711, 965,
+   567, 127, 987, 877, 622, 180, 110, 988, 101, 763, 874, 623, 268, 294, 283, 288,
+   447, 497, 921, 552,   0, 810, 821, 464, 266, 412, 568, 166, 827, 262,  25,   0,
+   769, 758, 856, 980,1007,  61, 946, 280, 853,   2, 855, 546, 708,   0, 806, 533,
+   292, 961, 917,   0, 139,1002, 513, 896, 202, 959,   0, 619, 550, 537, 741, 394,
+   905,   0, 742, 629, 833, 926, 893, 479, 116, 601, 540, 947, 626, 120,  32, 332,
+   785, 121, 577,   0,   0, 448, 404, 817, 218, 887, 403, 456, 762, 571, 470, 964,
+     0, 236, 971, 102, 636,  86, 498, 205, 124, 178, 502, 285, 471, 851, 575, 828,
+     0, 511, 950, 885, 143, 117, 888,   0,  68, 556,   0,   0, 870, 890, 712, 320,
+   415, 358, 839, 807, 842, 772, 995, 114, 603, 534, 227, 844,  49, 245, 151, 780,
+   505, 743, 429, 133, 238,  73,  54, 335, 811, 609,  93,   0, 581, 229,   0, 674,
+   372, 813, 495, 830, 749, 187, 167, 439, 319, 753, 608, 421, 671, 252, 795,  44,
+   209, 249,  15, 219, 315,   0,   0, 162, 633, 765, 881,  83, 150, 618, 535, 718,
+    89, 387, 213, 270, 276,   0, 898, 300, 492, 560, 399, 845, 602, 873, 938, 909,
+     0, 210, 892, 889, 441,  29, 791,  82, 793,   0, 715, 445, 142, 625, 826, 286,
+     0,  76, 325, 287, 432, 933, 779, 148, 709, 132, 710,   0, 380, 790, 768,  64,
+   361,  78, 591, 339, 138, 582,  24,  99, 707, 512, 515, 258, 910, 184,  65, 257,
+   297, 356, 614, 525, 558,  46, 472, 302, 485, 312,   0,   0, 465, 584, 350, 197,
+     0, 587,   0, 585, 125, 878, 390, 605, 217, 145, 908, 153, 340, 141, 831, 444,
+     0, 586, 411, 782, 489, 231, 822,   0,  60, 467, 688, 243, 891,1011, 431, 871,
+   990, 936, 506, 716, 457, 984, 808, 348, 393, 112, 316, 911, 453, 204, 799, 689,
+   264, 565, 462, 837,  19,  90, 963, 254, 637, 487, 222,   0, 859, 884,  87, 814,
+   359, 263, 111, 945, 482, 823,   0,   0, 191, 460, 508, 815, 388, 503, 418, 341,
+    62, 673,  50, 559, 976, 854,   0, 865, 296, 290, 278, 536, 969, 803, 574, 858,
+   481, 349,   0, 872, 269,   0, 675, 425, 787, 532, 434, 542, 704, 528, 398, 352,
+   408, 914,  31, 407, 496, 244, 207,   4, 381, 972,  21, 747, 867, 624,   0, 722,
+     0, 834, 343, 391, 627,1012, 797, 212, 416, 469, 310,   0, 115, 951, 557, 766,
+   519, 136,   0, 131, 895, 751, 355,  95, 713,  69, 576, 563,  37,   0, 771, 974,
+   592,  14, 750, 598, 337, 784, 868, 812, 857, 299, 109,   0, 836, 400, 706, 924,
+   759, 588, 206, 752, 410, 634, 916, 484, 137, 414, 589, 147, 942, 376,  12, 149,
+   303, 572, 486, 189, 992,  55, 461, 801, 430,1008, 307,   0, 172,   0,  77, 420,
+    59, 265,  43, 279, 918,   0, 920, 919, 397,   3, 466, 776, 775, 705, 840, 986,
+   242, 570,1001, 455, 635, 140, 476, 324, 880,   5,   0, 864,   0, 545,   0,   0,
+   569, 308, 796, 305, 957, 170, 186, 547, 326, 761, 989, 107, 366,  75, 250, 802,
+   395, 778, 606, 852, 113,   8, 321,   0, 347, 253, 915, 271, 931, 175, 135, 473,
+   590, 744,   0,   0, 362,1010, 978, 458,  66, 405, 767, 529, 997, 291, 774,  51,
+   155, 424, 783, 298,   9, 501, 996, 188, 786, 422,   0, 385, 610, 401, 607, 224,
+   295, 876, 596,   0, 129, 848, 159, 100, 442, 693,  57, 956, 894,  91, 493, 220,
+   953, 330, 805, 943, 118,1013, 346, 232, 126, 960, 413, 770, 757, 438, 174, 816,
+   777, 794, 165, 913, 903, 541, 866, 396, 620, 518, 234,   0, 168,  67,   0, 251,
+   520, 548, 255, 459, 423, 237,  98, 449, 169, 714, 962, 860, 284, 879, 678, 104,
+     0,  36, 930, 929, 904, 386, 973, 901, 760, 595,   0,   0, 103, 480, 267, 160,
+   720, 948, 616, 553, 260,  56, 214, 846,  84, 314,1004, 630, 922,  34, 122, 954,
+   593, 241, 478, 549, 228, 437,  58, 600,  42, 146,   0, 409, 334, 685, 993, 371,
+   580,   0, 717, 719, 756,  96,  41,   0, 273, 824, 367, 594, 272,  47,   6, 281,
+};
 
 #ifndef HB_OPTIMIZE_SIZE
 
@@ -52,6 +52,30 @@ hb_ucd_script (hb_unicode_funcs_t *ufuncs HB_UNUSED,
   return _hb_ucd_sc_map[_hb_ucd_sc (unicode)];
 }
 
+/* Batch versions of the above; they save a callback per code point. */
+#define HB_UCD_BATCH_FUNC(return_type, name, batch_name) \
+static void \
+hb_ucd_##batch_name (hb_unicode_funcs_t   *ufuncs, \
+		     unsigned int          count, \
+		     const hb_codepoint_t *first_unicode, \
+		     unsigned int          unicode_stride, \
+		     return_type          *first_result, \
+		     unsigned int          result_stride, \
+		     void                 *user_data) \
+{ \
+  for (unsigned int i = 0; i < count; i++) \
+  { \
+    *first_result = hb_ucd_##name (ufuncs, *first_unicode, user_data); \
+    first_unicode = &StructAtOffsetUnaligned<hb_codepoint_t> (first_unicode, unicode_stride); \
+    first_result = &StructAtOffsetUnaligned<return_type> (first_result, result_stride); \
+  } \
+}
+HB_UCD_BATCH_FUNC (hb_unicode_combining_class_t, combining_class, combining_classes)
+HB_UCD_BATCH_FUNC (hb_unicode_general_category_t, general_category, general_categories)
+HB_UCD_BATCH_FUNC (hb_codepoint_t, mirroring, mirrorings)
+HB_UCD_BATCH_FUNC (hb_script_t, script, scripts)
+#undef HB_UCD_BATCH_FUNC
+
 
 #define SBASE 0xAC00u
 #define LBASE 0x1100u
@@ -107,23 +131,6 @@ _hb_ucd_compose_hangul (hb_codepoint_t a, hb_codepoint_t b, hb_codepoint_t *ab)
     return false;
 }
 
-static int
-_cmp_pair (const void *_key, const void *_item)
-{
-  uint64_t& a = * (uint64_t*) _key;
-  uint64_t b = (* (uint64_t*) _item) & HB_CODEPOINT_ENCODE3(0x1FFFFFu, 0x1FFFFFu, 0);
-
-  return a < b ? -1 : a > b ? +1 : 0;
-}
-static int
-_cmp_pair_11_7_14 (const void *_key, const void *_item)
-{
-  uint32_t& a = * (uint32_t*) _key;
-  uint32_t b = (* (uint32_t*) _item) & HB_CODEPOINT_ENCODE3_11_7_14(0x1FFFFFu, 0x1FFFFFu, 0);
-
-  return a < b ? -1 : a > b ? +1 : 0;
-}
-
 static hb_bool_t
 hb_ucd_compose (hb_unicode_funcs_t *ufuncs HB_UNUSED,
 		hb_codepoint_t a, hb_codepoint_t b, hb_codepoint_t *ab,
@@ -132,37 +139,40 @@ hb_ucd_compose (hb_unicode_funcs_t *ufuncs HB_UNUSED,
   // Hangul is handled algorithmically.
   if (_hb_ucd_compose_hangul (a, b, ab)) return true;
 
-  hb_codepoint_t u = 0;
+  /* The "a,b" pairs that compose are found through a perfect hash
+   * into the decomposition arrays.  A hit still needs checking, since
+   * every pair lands in some slot.  The constants must match
+   * gen-ucd-table.py. */
+  uint32_t h = a * 0x9E3779B1u ^ b * 0x85EBCA77u;
+  h ^= h >> 15;
+  unsigned seed = _hb_ucd_dm2_hash_seed[h >> (32 - 9)];
+  unsigned i = _hb_ucd_dm2_hash_map[((h ^ seed) * 0x2C1B3C6Du) >> (32 - 10)];
+  static_assert (ARRAY_LENGTH_CONST (_hb_ucd_dm2_hash_seed) == 1 << 9, "");
+  static_assert (ARRAY_LENGTH_CONST (_hb_ucd_dm2_hash_map) == 1 << 10, "");
+
+  if (likely (!i)) return false;
+  i--;
 
-  if ((a & 0xFFFFF800u) == 0x0000u && (b & 0xFFFFFF80) == 0x0300u)
+  hb_codepoint_t u;
+  if (i < ARRAY_LENGTH (_hb_ucd_dm2_u32_map))
   {
-    /* If "a" is small enough and "b" is in the U+0300 range,
-     * the composition data is encoded in a 32bit array sorted
-     * by "a,b" pair. */
-    uint32_t k = HB_CODEPOINT_ENCODE3_11_7_14 (a, b, 0);
-    const uint32_t *v = hb_bsearch (k,
-				    _hb_ucd_dm2_u32_map,
-				    ARRAY_LENGTH (_hb_ucd_dm2_u32_map),
-				    sizeof (*_hb_ucd_dm2_u32_map),
-				    _cmp_pair_11_7_14);
-    if (likely (!v)) return false;
-    u = HB_CODEPOINT_DECODE3_11_7_14_3 (*v);
+    /* 32bit array. */
+    uint32_t v = _hb_ucd_dm2_u32_map[i];
+    if (HB_CODEPOINT_DECODE3_11_7_14_1 (v) != a ||
+	HB_CODEPOINT_DECODE3_11_7_14_2 (v) != b)
+      return false;
+    u = HB_CODEPOINT_DECODE3_11_7_14_3 (v);
   }
   else
   {
-    /* Otherwise it is stored in a 64bit array sorted by
-     * "a,b" pair. */
-    uint64_t k = HB_CODEPOINT_ENCODE3 (a, b, 0);
-    const uint64_t *v = hb_bsearch (k,
-				    _hb_ucd_dm2_u64_map,
-				    ARRAY_LENGTH (_hb_ucd_dm2_u64_map),
-				    sizeof (*_hb_ucd_dm2_u64_map),
-				    _cmp_pair);
-    if (likely (!v)) return false;
-    u = HB_CODEPOINT_DECODE3_3 (*v);
+    /* 64bit array. */
+    uint64_t v = _hb_ucd_dm2_u64_map[i - ARRAY_LENGTH (_hb_ucd_dm2_u32_map)];
+    if (HB_CODEPOINT_DECODE3_1 (v) != a ||
+	HB_CODEPOINT_DECODE3_2 (v) != b)
+      return false;
+    u = HB_CODEPOINT_DECODE3_3 (v);
   }
 
-  if (unlikely (!u)) return false;
   *ab = u;
   return true;
 }
@@ -233,6 +243,11 @@ static struct hb_ucd_unicode_funcs_lazy_loader_t : hb_unicode_funcs_lazy_loader_
     hb_unicode_funcs_set_script_func (funcs, hb_ucd_script, nullptr, nullptr);
     hb_unicode_funcs_set_compose_func (funcs, hb_ucd_compose, nullptr, nullptr);
     hb_unicode_funcs_set_decompose_func (funcs, hb_ucd_decompose, nullptr, nullptr);
+    /* After the simple callbacks; setting those resets these. */
+    hb_unicode_funcs_set_combining_classes_func (funcs, hb_ucd_combining_classes, nullptr, nullptr);
+    hb_unicode_funcs_set_general_categories_func (funcs, hb_ucd_general_categories, nullptr, nullptr);
+    hb_unicode_funcs_set_mirrorings_func (funcs, hb_ucd_mirrorings, nullptr, nullptr);
+    hb_unicode_funcs_set_scripts_func (funcs, hb_ucd_scripts, nullptr, nullptr);
 
     hb_unicode_funcs_make_immutable (funcs);
 
@@ -31,6 +31,7 @@
 #include "hb.hh"
 
 #include "hb-unicode.hh"
+#include "hb-utf.hh"
 
 
 /**
@@ -131,6 +132,81 @@ hb_unicode_decompose_compatibility_nil (hb_unicode_funcs_t *ufuncs     HB_UNUSED
 }
 #endif
 
+#define HB_UNICODE_FUNC_IMPLEMENT(return_type, name, batch_name) \
+static void \
+hb_unicode_##batch_name##_nil (hb_unicode_funcs_t   *ufuncs, \
+			      unsigned int          count, \
+			      const hb_codepoint_t *first_unicode, \
+			      unsigned int          unicode_stride, \
+			      return_type          *first_result, \
+			      unsigned int          result_stride, \
+			      void                 *user_data HB_UNUSED) \
+{ \
+  for (unsigned int i = 0; i < count; i++) \
+  { \
+    *first_result = ufuncs->name (*first_unicode); \
+    first_unicode = &StructAtOffsetUnaligned<hb_codepoint_t> (first_unicode, unicode_stride); \
+    first_result = &StructAtOffsetUnaligned<return_type> (first_result, result_stride); \
+  } \
+}
+HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_BATCH
+#undef HB_UNICODE_FUNC_IMPLEMENT
+
+/* Keeps each batch callback in agreement with the simple callback it
+ * batches, after either of them was set on ufuncs:
+ *
+ * - Setting the simple callback resets the batch one to the default,
+ *   which loops over the simple callback.  Unsetting it goes back to the
+ *   parent's pair, if the batch callback was the default.
+ *
+ * - Unsetting the batch callback goes back to the parent's, unless the
+ *   simple callback is not the parent's anymore.
+ */
+static void
+_hb_unicode_funcs_sync_batch (hb_unicode_funcs_t *ufuncs,
+			      const void         *slot,
+			      bool                is_set)
+{
+#define HB_UNICODE_FUNC_IMPLEMENT(return_type, name, batch_name) \
+  if (slot == &ufuncs->func.name || slot == &ufuncs->func.batch_name) \
+  { \
+    bool simple_inherited = ufuncs->func.name == ufuncs->parent->func.name && \
+			    ufuncs->user_data.name == ufuncs->parent->user_data.name; \
+    bool use_default; \
+    if (slot == &ufuncs->func.name) \
+    { \
+      if (is_set) \
+	use_default = true; \
+      else if (ufuncs->func.batch_name == hb_unicode_##batch_name##_nil) \
+	use_default = false; \
+      else \
+	return; \
+    } \
+    else \
+    { \
+      if (is_set || simple_inherited) \
+	return; \
+      use_default = true; \
+    } \
+    if (ufuncs->destroy.batch_name) \
+      ufuncs->destroy.batch_name (ufuncs->user_data.batch_name); \
+    ufuncs->destroy.batch_name = nullptr; \
+    if (use_default) \
+    { \
+      ufuncs->func.batch_name = hb_unicode_##batch_name##_nil; \
+      ufuncs->user_data.batch_name = nullptr; \
+    } \
+    else \
+    { \
+      ufuncs->func.batch_name = ufuncs->parent->func.batch_name; \
+      ufuncs->user_data.batch_name = ufuncs->parent->user_data.batch_name; \
+    } \
+    return; \
+  }
+  HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_BATCH
+#undef HB_UNICODE_FUNC_IMPLEMENT
+}
+
 #if !defined(HB_NO_UNICODE_FUNCS) && defined(HAVE_GLIB)
 #include "hb-glib.h"
 #endif
@@ -396,6 +472,7 @@ hb_unicode_funcs_set_##name##_func (hb_unicode_funcs_t		   *ufuncs,	\
     ufuncs->func.name = ufuncs->parent->func.name;				\
   ufuncs->user_data.name = user_data;						\
   ufuncs->destroy.name = destroy;						\
+  _hb_unicode_funcs_sync_batch (ufuncs, &ufuncs->func.name, func != nullptr);\
   return;									\
 										\
 fail:										\
@@ -418,6 +495,23 @@ hb_unicode_##name (hb_unicode_funcs_t *ufuncs,					\
 HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_SIMPLE
 #undef HB_UNICODE_FUNC_IMPLEMENT
 
+#define HB_UNICODE_FUNC_IMPLEMENT(return_type, name, batch_name)		\
+										\
+void										\
+hb_unicode_##batch_name (hb_unicode_funcs_t   *ufuncs,				\
+			 unsigned int          count,				\
+			 const hb_codepoint_t *first_unicode,			\
+			 unsigned int          unicode_stride,			\
+			 return_type          *first_result,			\
+			 unsigned int          result_stride)			\
+{										\
+  ufuncs->batch_name (count,							\
+		      first_unicode, unicode_stride,				\
+		      first_result, result_stride);				\
+}
+HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_BATCH
+#undef HB_UNICODE_FUNC_IMPLEMENT
+
 /**
  * hb_unicode_compose:
  * @ufuncs: The Unicode-functions structure
@@ -494,6 +588,279 @@ hb_unicode_decompose_compatibility (hb_unicode_funcs_t *ufuncs,
 #endif
 
 
+/*
+ * Script itemization
+ */
+
+/* The ASCII shortcuts below hard-code the answers of the built-in UCD
+ * functions, so only take them for those; any other funcs, including
+ * ones overriding the UCD, are always asked. */
+static inline bool
+_hb_unicode_funcs_is_ucd (hb_unicode_funcs_t *ufuncs)
+{
+#ifndef HB_NO_UCD
+  return ufuncs == hb_ucd_get_unicode_funcs ();
+#else
+  return false;
+#endif
+}
+
+static inline bool
+_hb_unicode_is_open_bracket (hb_unicode_funcs_t *ufuncs, bool is_ucd, hb_codepoint_t u)
+{
+  if (is_ucd && u < 0x80u)
+    return u == '(' || u == '[' || u == '{';
+  return ufuncs->general_category (u) == HB_UNICODE_GENERAL_CATEGORY_OPEN_PUNCTUATION &&
+	 ufuncs->mirroring (u) != u;
+}
+
+static inline bool
+_hb_unicode_is_close_bracket (hb_unicode_funcs_t *ufuncs, bool is_ucd, hb_codepoint_t u)
+{
+  if (is_ucd && u < 0x80u)
+    return u == ')' || u == ']' || u == '}';
+  return ufuncs->general_category (u) == HB_UNICODE_GENERAL_CATEGORY_CLOSE_PUNCTUATION;
+}
+
+template <typename utf_t>
+static unsigned int
+_hb_unicode_script_runs (hb_unicode_funcs_t                *ufuncs,
+			 const typename utf_t::codepoint_t *text,
+			 int                                text_length,
+			 unsigned int                       start_offset,
+			 unsigned int                      *run_count,
+			 hb_unicode_script_run_t           *runs)
+{
+  typedef typename utf_t::codepoint_t T;
+
+  if (text_length == -1)
+    text_length = utf_t::strlen (text);
+
+  unsigned int max_runs = *run_count;
+  *run_count = 0;
+  if (unlikely (start_offset >= (unsigned int) text_length))
+    return text_length;
+  if (unlikely (!max_runs))
+    return start_offset;
+
+  const T *next = text + start_offset;
+  const T *end = text + text_length;
+  const bool is_ucd = _hb_unicode_funcs_is_ucd (ufuncs);
+
+  /* Paired brackets take the script of their opening bracket, as in
+   * UAX #24 Section 5.1; the stack holds the expected closing bracket
+   * for each one still open.  Entries pushed before the run's script
+   * is known are fixed up once it is. */
+  struct bracket_t
+  {
+    hb_codepoint_t close;
+    hb_script_t script;
+  } stack[32];
+  unsigned int depth = 0;
+
+  unsigned int n_runs = 0;
+  hb_unicode_script_run_t *run = &runs[0];
+  *run = {start_offset, 0, HB_SCRIPT_COMMON, HB_DIRECTION_INVALID, nullptr, nullptr};
+
+  auto finish_run = [&] (unsigned int offset)
+  {
+    run->length = offset - run->offset;
+    run->direction = hb_script_get_horizontal_direction (run->script);
+    if (run->direction == HB_DIRECTION_INVALID)
+      run->direction = HB_DIRECTION_LTR;
+    n_runs++;
+  };
+
+  /* Decode and look up scripts a chunk at a time, so that the
+   * lookups go through the batch callback. */
+  hb_codepoint_t unicodes[64];
+  hb_script_t scripts[64];
+  unsigned int offsets[64];
+  while (next < end)
+  {
+    unsigned int count = 0;
+    hb_codepoint_t all = 0;
+    while (count < ARRAY_LENGTH (unicodes) && next < end)
+    {
+      offsets[count] = next - text;
+      next = utf_t::next (next, end, &unicodes[count], 0xFFFDu);
+      all |= unicodes[count];
+      count++;
+    }
+
+    if (is_ucd && all < 0x80u)
+      for (unsigned int i = 0; i < count; i++)
+	scripts[i] = ISALPHA (unicodes[i]) ? HB_SCRIPT_LATIN : HB_SCRIPT_COMMON;
+    else
+      ufuncs->scripts (count,
+		       unicodes, sizeof (unicodes[0]),
+		       scripts, sizeof (scripts[0]));
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+      hb_codepoint_t u = unicodes[i];
+      hb_script_t script = scripts[i];
+
+      if (script == HB_SCRIPT_COMMON)
+      {
+	if (_hb_unicode_is_open_bracket (ufuncs, is_ucd, u))
+	{
+	  if (unlikely (depth == ARRAY_LENGTH (stack)))
+	  {
+	    memmove (stack, stack + 1, (depth - 1) * sizeof (stack[0]));
+	    depth--;
+	  }
+	  stack[depth++] = {ufuncs->mirroring (u), run->script};
+	}
+	else if (depth && _hb_unicode_is_close_bracket (ufuncs, is_ucd, u))
+	{
+	  for (unsigned int j = depth; j; j--)
+	    if (stack[j - 1].close == u)
+	    {
+	      depth = j - 1;
+	      script = stack[depth].script;
+	      break;
+	    }
+	}
+      }
+
+      if (script == HB_SCRIPT_COMMON ||
+	  script == HB_SCRIPT_INHERITED ||
+	  script == HB_SCRIPT_UNKNOWN ||
+	  script == run->script)
+	continue;
+
+      if (run->script == HB_SCRIPT_COMMON)
+      {
+	run->script = script;
+	for (unsigned int j = 0; j < depth; j++)
+	  if (stack[j].script == HB_SCRIPT_COMMON)
+	    stack[j].script = script;
+	continue;
+      }
+
+      finish_run (offsets[i]);
+      if (n_runs == max_runs)
+      {
+	*run_count = n_runs;
+	return offsets[i];
+      }
+      run = &runs[n_runs];
+      *run = {offsets[i], 0, script, HB_DIRECTION_INVALID, nullptr, nullptr};
+    }
+  }
+
+  finish_run (text_length);
+  *run_count = n_runs;
+  return text_length;
+}
+
+/**
+ * hb_unicode_script_runs_utf8:
+ * @ufuncs: The Unicode-functions structure
+ * @text: (array length=text_length): UTF-8 text to itemize
+ * @text_length: The length of @text, or -1 if it is `NULL` terminated
+ * @start_offset: The offset of the first code unit to itemize
+ * @run_count: (inout): The maximum number of runs to return;
+ *             set to the number of runs returned
+ * @runs: (out) (array length=run_count): The script runs
+ *
+ * Splits @text, starting at @start_offset, into runs of a single
+ * script, using the script function of @ufuncs.
+ *
+ * Characters of the Common, Inherited and Unknown scripts join the
+ * surrounding run; at the start of the text they join the first run
+ * with a real script.  Paired brackets take the script of the text
+ * their opening bracket is in.  A run that contains only such
+ * characters has script #HB_SCRIPT_COMMON.
+ *
+ * The direction of each run is the horizontal direction of its
+ * script as returned by hb_script_get_horizontal_direction(), or
+ * #HB_DIRECTION_LTR if that is #HB_DIRECTION_INVALID.  This is the
+ * same guess hb_buffer_guess_segment_properties() makes; it is not a
+ * substitute for the Unicode Bidirectional Algorithm.
+ *
+ * If @runs fills up before the end of the text, the return value is
+ * the offset at which the next run starts; pass it back as
+ * @start_offset to continue.  Paired-bracket state is not carried
+ * across such calls.
+ *
+ * Return value: The offset at which itemization stopped; the length
+ * of @text if all of it was itemized
+ *
+ * Since: REPLACEME
+ **/
+unsigned int
+hb_unicode_script_runs_utf8 (hb_unicode_funcs_t      *ufuncs,
+			     const char              *text,
+			     int                      text_length,
+			     unsigned int             start_offset,
+			     unsigned int            *run_count /* IN/OUT */,
+			     hb_unicode_script_run_t *runs /* OUT */)
+{
+  return _hb_unicode_script_runs<hb_utf8_t> (ufuncs, (const uint8_t *) text, text_length,
+					     start_offset, run_count, runs);
+}
+
+/**
+ * hb_unicode_script_runs_utf16:
+ * @ufuncs: The Unicode-functions structure
+ * @text: (array length=text_length): UTF-16 text to itemize
+ * @text_length: The length of @text, or -1 if it is `NULL` terminated
+ * @start_offset: The offset of the first code unit to itemize
+ * @run_count: (inout): The maximum number of runs to return;
+ *             set to the number of runs returned
+ * @runs: (out) (array length=run_count): The script runs
+ *
+ * Like hb_unicode_script_runs_utf8(), but for UTF-16 text.
+ *
+ * Return value: The offset at which itemization stopped; the length
+ * of @text if all of it was itemized
+ *
+ * Since: REPLACEME
+ **/
+unsigned int
+hb_unicode_script_runs_utf16 (hb_unicode_funcs_t      *ufuncs,
+			      const uint16_t          *text,
+			      int                      text_length,
+			      unsigned int             start_offset,
+			      unsigned int            *run_count /* IN/OUT */,
+			      hb_unicode_script_run_t *runs /* OUT */)
+{
+  return _hb_unicode_script_runs<hb_utf16_t> (ufuncs, text, text_length,
+					      start_offset, run_count, runs);
+}
+
+/**
+ * hb_unicode_script_runs_utf32:
+ * @ufuncs: The Unicode-functions structure
+ * @text: (array length=text_length): UTF-32 text to itemize
+ * @text_length: The length of @text, or -1 if it is `NULL` terminated
+ * @start_offset: The offset of the first code unit to itemize
+ * @run_count: (inout): The maximum number of runs to return;
+ *             set to the number of runs returned
+ * @runs: (out) (array length=run_count): The script runs
+ *
+ * Like hb_unicode_script_runs_utf8(), but for UTF-32 text.
+ *
+ * Return value: The offset at which itemization stopped; the length
+ * of @text if all of it was itemized
+ *
+ * Since: REPLACEME
+ **/
+unsigned int
+hb_unicode_script_runs_utf32 (hb_unicode_funcs_t      *ufuncs,
+			      const uint32_t          *text,
+			      int                      text_length,
+			      unsigned int             start_offset,
+			      unsigned int            *run_count /* IN/OUT */,
+			      hb_unicode_script_run_t *runs /* OUT */)
+{
+  return _hb_unicode_script_runs<hb_utf32_t> (ufuncs, text, text_length,
+					      start_offset, run_count, runs);
+}
+
+
 #ifndef HB_NO_OT_SHAPE
 /* See hb-unicode.hh for details. */
 const uint8_t
@@ -462,6 +462,129 @@ typedef hb_bool_t			(*hb_unicode_decompose_func_t)		(hb_unicode_funcs_t *ufuncs,
 										 hb_codepoint_t     *b,
 										 void               *user_data);
 
+/**
+ * hb_unicode_combining_classes_func_t:
+ * @ufuncs: A Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_combining_class: (out): The first result
+ * @combining_class_stride: The stride between successive results
+ * @user_data: User data pointer passed by the caller
+ *
+ * A virtual method for the #hb_unicode_funcs_t structure.
+ *
+ * This method should retrieve the Canonical Combining Class (ccc)
+ * property for a run of Unicode code points, as
+ * #hb_unicode_combining_class_func_t would for each.
+ *
+ * If not set, a default implementation calling
+ * #hb_unicode_combining_class_func_t for each code point is used.
+ * Setting the #hb_unicode_combining_class_func_t callback resets
+ * this one to that default, so the two can't disagree.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_unicode_combining_classes_func_t) (hb_unicode_funcs_t *ufuncs,
+						     unsigned int count,
+						     const hb_codepoint_t *first_unicode,
+						     unsigned int unicode_stride,
+						     hb_unicode_combining_class_t *first_combining_class,
+						     unsigned int combining_class_stride,
+						     void *user_data);
+
+/**
+ * hb_unicode_general_categories_func_t:
+ * @ufuncs: A Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_category: (out): The first result
+ * @category_stride: The stride between successive results
+ * @user_data: User data pointer passed by the caller
+ *
+ * A virtual method for the #hb_unicode_funcs_t structure.
+ *
+ * This method should retrieve the General Category (gc) property for
+ * a run of Unicode code points, as
+ * #hb_unicode_general_category_func_t would for each.
+ *
+ * If not set, a default implementation calling
+ * #hb_unicode_general_category_func_t for each code point is used.
+ * Setting the #hb_unicode_general_category_func_t callback resets
+ * this one to that default, so the two can't disagree.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_unicode_general_categories_func_t) (hb_unicode_funcs_t *ufuncs,
+						      unsigned int count,
+						      const hb_codepoint_t *first_unicode,
+						      unsigned int unicode_stride,
+						      hb_unicode_general_category_t *first_category,
+						      unsigned int category_stride,
+						      void *user_data);
+
+/**
+ * hb_unicode_mirrorings_func_t:
+ * @ufuncs: A Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_mirroring: (out): The first result
+ * @mirroring_stride: The stride between successive results
+ * @user_data: User data pointer passed by the caller
+ *
+ * A virtual method for the #hb_unicode_funcs_t structure.
+ *
+ * This method should retrieve the Bi-Directional Mirroring Glyph
+ * code point for a run of Unicode code points, as
+ * #hb_unicode_mirroring_func_t would for each.
+ *
+ * If not set, a default implementation calling
+ * #hb_unicode_mirroring_func_t for each code point is used.  Setting
+ * the #hb_unicode_mirroring_func_t callback resets this one to that
+ * default, so the two can't disagree.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_unicode_mirrorings_func_t) (hb_unicode_funcs_t *ufuncs,
+					      unsigned int count,
+					      const hb_codepoint_t *first_unicode,
+					      unsigned int unicode_stride,
+					      hb_codepoint_t *first_mirroring,
+					      unsigned int mirroring_stride,
+					      void *user_data);
+
+/**
+ * hb_unicode_scripts_func_t:
+ * @ufuncs: A Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_script: (out): The first result
+ * @script_stride: The stride between successive results
+ * @user_data: User data pointer passed by the caller
+ *
+ * A virtual method for the #hb_unicode_funcs_t structure.
+ *
+ * This method should retrieve the Script property for a run of
+ * Unicode code points, as #hb_unicode_script_func_t would for each.
+ *
+ * If not set, a default implementation calling
+ * #hb_unicode_script_func_t for each code point is used.  Setting
+ * the #hb_unicode_script_func_t callback resets this one to that
+ * default, so the two can't disagree.
+ *
+ * Since: REPLACEME
+ **/
+typedef void (*hb_unicode_scripts_func_t) (hb_unicode_funcs_t *ufuncs,
+					   unsigned int count,
+					   const hb_codepoint_t *first_unicode,
+					   unsigned int unicode_stride,
+					   hb_script_t *first_script,
+					   unsigned int script_stride,
+					   void *user_data);
+
 /* func setters */
 
 /**
@@ -560,6 +683,70 @@ hb_unicode_funcs_set_decompose_func (hb_unicode_funcs_t *ufuncs,
 				     hb_unicode_decompose_func_t func,
 				     void *user_data, hb_destroy_func_t destroy);
 
+/**
+ * hb_unicode_funcs_set_combining_classes_func:
+ * @ufuncs: A Unicode-functions structure
+ * @func: (closure user_data) (destroy destroy) (scope notified): The callback function to assign
+ * @user_data: Data to pass to @func
+ * @destroy: (nullable): The function to call when @user_data is not needed anymore
+ *
+ * Sets the implementation function for #hb_unicode_combining_classes_func_t.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_funcs_set_combining_classes_func (hb_unicode_funcs_t *ufuncs,
+					     hb_unicode_combining_classes_func_t func,
+					     void *user_data, hb_destroy_func_t destroy);
+
+/**
+ * hb_unicode_funcs_set_general_categories_func:
+ * @ufuncs: A Unicode-functions structure
+ * @func: (closure user_data) (destroy destroy) (scope notified): The callback function to assign
+ * @user_data: Data to pass to @func
+ * @destroy: (nullable): The function to call when @user_data is not needed anymore
+ *
+ * Sets the implementation function for #hb_unicode_general_categories_func_t.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_funcs_set_general_categories_func (hb_unicode_funcs_t *ufuncs,
+					      hb_unicode_general_categories_func_t func,
+					      void *user_data, hb_destroy_func_t destroy);
+
+/**
+ * hb_unicode_funcs_set_mirrorings_func:
+ * @ufuncs: A Unicode-functions structure
+ * @func: (closure user_data) (destroy destroy) (scope notified): The callback function to assign
+ * @user_data: Data to pass to @func
+ * @destroy: (nullable): The function to call when @user_data is not needed anymore
+ *
+ * Sets the implementation function for #hb_unicode_mirrorings_func_t.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_funcs_set_mirrorings_func (hb_unicode_funcs_t *ufuncs,
+				      hb_unicode_mirrorings_func_t func,
+				      void *user_data, hb_destroy_func_t destroy);
+
+/**
+ * hb_unicode_funcs_set_scripts_func:
+ * @ufuncs: A Unicode-functions structure
+ * @func: (closure user_data) (destroy destroy) (scope notified): The callback function to assign
+ * @user_data: Data to pass to @func
+ * @destroy: (nullable): The function to call when @user_data is not needed anymore
+ *
+ * Sets the implementation function for #hb_unicode_scripts_func_t.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_funcs_set_scripts_func (hb_unicode_funcs_t *ufuncs,
+				   hb_unicode_scripts_func_t func,
+				   void *user_data, hb_destroy_func_t destroy);
+
 /* accessors */
 
 /**
@@ -638,6 +825,143 @@ hb_unicode_decompose (hb_unicode_funcs_t *ufuncs,
 		      hb_codepoint_t     *a,
 		      hb_codepoint_t     *b);
 
+/**
+ * hb_unicode_combining_classes:
+ * @ufuncs: The Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: (array length=count): The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_combining_class: (out): The first result
+ * @combining_class_stride: The stride between successive results
+ *
+ * Retrieves the Canonical Combining Class (ccc) property of @count
+ * code points, like calling hb_unicode_combining_class() on each of
+ * them.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_combining_classes (hb_unicode_funcs_t *ufuncs,
+			      unsigned int count,
+			      const hb_codepoint_t *first_unicode,
+			      unsigned int unicode_stride,
+			      hb_unicode_combining_class_t *first_combining_class,
+			      unsigned int combining_class_stride);
+
+/**
+ * hb_unicode_general_categories:
+ * @ufuncs: The Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: (array length=count): The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_category: (out): The first result
+ * @category_stride: The stride between successive results
+ *
+ * Retrieves the General Category (gc) property of @count code
+ * points, like calling hb_unicode_general_category() on each of
+ * them.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_general_categories (hb_unicode_funcs_t *ufuncs,
+			       unsigned int count,
+			       const hb_codepoint_t *first_unicode,
+			       unsigned int unicode_stride,
+			       hb_unicode_general_category_t *first_category,
+			       unsigned int category_stride);
+
+/**
+ * hb_unicode_mirrorings:
+ * @ufuncs: The Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: (array length=count): The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_mirroring: (out): The first result
+ * @mirroring_stride: The stride between successive results
+ *
+ * Retrieves the Bi-Directional Mirroring Glyph code point of @count
+ * code points, like calling hb_unicode_mirroring() on each of them.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_mirrorings (hb_unicode_funcs_t *ufuncs,
+		       unsigned int count,
+		       const hb_codepoint_t *first_unicode,
+		       unsigned int unicode_stride,
+		       hb_codepoint_t *first_mirroring,
+		       unsigned int mirroring_stride);
+
+/**
+ * hb_unicode_scripts:
+ * @ufuncs: The Unicode-functions structure
+ * @count: number of code points to query
+ * @first_unicode: (array length=count): The first code point to query
+ * @unicode_stride: The stride between successive code points
+ * @first_script: (out): The first result
+ * @script_stride: The stride between successive results
+ *
+ * Retrieves the Script property of @count code points, like calling
+ * hb_unicode_script() on each of them.
+ *
+ * Since: REPLACEME
+ **/
+HB_EXTERN void
+hb_unicode_scripts (hb_unicode_funcs_t *ufuncs,
+		    unsigned int count,
+		    const hb_codepoint_t *first_unicode,
+		    unsigned int unicode_stride,
+		    hb_script_t *first_script,
+		    unsigned int script_stride);
+
+/**
+ * hb_unicode_script_run_t:
+ * @offset: The offset of the run's first code unit in the text
+ * @length: The number of code units in the run
+ * @script: The script of the run
+ * @direction: The horizontal direction of @script
+ *
+ * A run of text in a single script, as returned by
+ * hb_unicode_script_runs_utf8() and friends.
+ *
+ * Since: REPLACEME
+ **/
+typedef struct hb_unicode_script_run_t {
+  unsigned int   offset;
+  unsigned int   length;
+  hb_script_t    script;
+  hb_direction_t direction;
+
+  /*< private >*/
+  void *reserved1;
+  void *reserved2;
+} hb_unicode_script_run_t;
+
+HB_EXTERN unsigned int
+hb_unicode_script_runs_utf8 (hb_unicode_funcs_t      *ufuncs,
+			     const char              *text,
+			     int                      text_length,
+			     unsigned int             start_offset,
+			     unsigned int            *run_count /* IN/OUT */,
+			     hb_unicode_script_run_t *runs /* OUT */);
+
+HB_EXTERN unsigned int
+hb_unicode_script_runs_utf16 (hb_unicode_funcs_t      *ufuncs,
+			      const uint16_t          *text,
+			      int                      text_length,
+			      unsigned int             start_offset,
+			      unsigned int            *run_count /* IN/OUT */,
+			      hb_unicode_script_run_t *runs /* OUT */);
+
+HB_EXTERN unsigned int
+hb_unicode_script_runs_utf32 (hb_unicode_funcs_t      *ufuncs,
+			      const uint32_t          *text,
+			      int                      text_length,
+			      unsigned int             start_offset,
+			      unsigned int            *run_count /* IN/OUT */,
+			      hb_unicode_script_run_t *runs /* OUT */);
+
 HB_END_DECLS
 
 #endif /* HB_UNICODE_H */
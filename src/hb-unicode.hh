@@ -49,6 +49,10 @@ extern HB_INTERNAL const uint8_t _hb_modified_combining_class[256];
   HB_UNICODE_FUNC_IMPLEMENT (compose) \
   HB_UNICODE_FUNC_IMPLEMENT (decompose) \
   HB_IF_NOT_DEPRECATED (HB_UNICODE_FUNC_IMPLEMENT (decompose_compatibility)) \
+  HB_UNICODE_FUNC_IMPLEMENT (combining_classes) \
+  HB_UNICODE_FUNC_IMPLEMENT (general_categories) \
+  HB_UNICODE_FUNC_IMPLEMENT (mirrorings) \
+  HB_UNICODE_FUNC_IMPLEMENT (scripts) \
   /* ^--- Add new callbacks here */
 
 /* Simple callbacks are those taking a hb_codepoint_t and returning a hb_codepoint_t */
@@ -60,6 +64,15 @@ extern HB_INTERNAL const uint8_t _hb_modified_combining_class[256];
   HB_UNICODE_FUNC_IMPLEMENT (hb_script_t, script) \
   /* ^--- Add new simple callbacks here */
 
+/* Batch callbacks are simple callbacks run over an array of code points;
+ * each is listed with the simple callback it defaults to looping over. */
+#define HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_BATCH \
+  HB_UNICODE_FUNC_IMPLEMENT (hb_unicode_combining_class_t, combining_class, combining_classes) \
+  HB_UNICODE_FUNC_IMPLEMENT (hb_unicode_general_category_t, general_category, general_categories) \
+  HB_UNICODE_FUNC_IMPLEMENT (hb_codepoint_t, mirroring, mirrorings) \
+  HB_UNICODE_FUNC_IMPLEMENT (hb_script_t, script, scripts) \
+  /* ^--- Add new batch callbacks here */
+
 struct hb_unicode_funcs_t
 {
   hb_object_header_t header;
@@ -69,6 +82,19 @@ struct hb_unicode_funcs_t
 #define HB_UNICODE_FUNC_IMPLEMENT(return_type, name) \
   return_type name (hb_codepoint_t unicode) { return func.name (this, unicode, user_data.name); }
 HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_SIMPLE
+#undef HB_UNICODE_FUNC_IMPLEMENT
+
+#define HB_UNICODE_FUNC_IMPLEMENT(return_type, name, batch_name) \
+  void batch_name (unsigned int count, \
+		   const hb_codepoint_t *first_unicode, unsigned int unicode_stride, \
+		   return_type *first_result, unsigned int result_stride) \
+  { \
+    func.batch_name (this, count, \
+		     first_unicode, unicode_stride, \
+		     first_result, result_stride, \
+		     user_data.batch_name); \
+  }
+HB_UNICODE_FUNCS_IMPLEMENT_CALLBACKS_BATCH
 #undef HB_UNICODE_FUNC_IMPLEMENT
 
   hb_bool_t compose (hb_codepoint_t a, hb_codepoint_t b,
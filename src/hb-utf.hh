@@ -123,6 +123,27 @@ struct hb_utf8_t
     return end - 1;
   }
 
+  /* Returns the end of the run of code units at text that each decode to
+   * their own value; ASCII for UTF-8.  Checks eight bytes at a time. */
+  static const codepoint_t *
+  skip_trivial (const codepoint_t *text,
+		const codepoint_t *end)
+  {
+    if (text < end && *text >= 0x80u)
+      return text;
+    while (end - text >= 8)
+    {
+      uint64_t v;
+      hb_memcpy (&v, text, sizeof (v));
+      if (v & 0x8080808080808080ull)
+	break;
+      text += 8;
+    }
+    while (text < end && *text < 0x80u)
+      text++;
+    return text;
+  }
+
   static unsigned int
   strlen (const codepoint_t *text)
   { return ::strlen ((const char *) text); }
@@ -249,6 +270,15 @@ struct hb_utf16_xe_t
     return text;
   }
 
+  /* Returns the end of the run of non-surrogate code units at text. */
+  static const codepoint_t *
+  skip_trivial (const codepoint_t *text,
+		const codepoint_t *end)
+  {
+    while (text < end && !hb_in_range<hb_codepoint_t> (*text, 0xD800u, 0xDFFFu))
+      text++;
+    return text;
+  }
 
   static unsigned int
   strlen (const codepoint_t *text)
@@ -318,6 +348,22 @@ struct hb_utf32_xe_t
     return text;
   }
 
+  /* Returns the end of the run of valid codepoints at text. */
+  static const TCodepoint *
+  skip_trivial (const TCodepoint *text,
+		const TCodepoint *end)
+  {
+    if (!validate) return end;
+    while (text < end)
+    {
+      hb_codepoint_t c = *text;
+      if (unlikely (c >= 0xD800u && (c <= 0xDFFFu || c > 0x10FFFFu)))
+	break;
+      text++;
+    }
+    return text;
+  }
+
   static unsigned int
   strlen (const TCodepoint *text)
   {
@@ -373,6 +419,11 @@ struct hb_latin1_t
     return text;
   }
 
+  static const codepoint_t *
+  skip_trivial (const codepoint_t *text HB_UNUSED,
+		const codepoint_t *end)
+  { return end; }
+
   static unsigned int
   strlen (const codepoint_t *text)
   {
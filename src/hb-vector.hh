@@ -33,9 +33,26 @@
 #include "hb-null.hh"
 
 
+/* Storage for the first few items of a vector, kept inside the vector
+ * object itself, so that short-lived vectors which stay small never
+ * touch the heap.  Empty (and optimized away) when no inline items are
+ * requested. */
+template <typename Type, unsigned int inline_size>
+struct hb_vector_inline_storage_t
+{
+  Type *inline_array () { return reinterpret_cast<Type *> (bytes); }
+  alignas (Type) char bytes[inline_size * sizeof (Type)];
+};
+template <typename Type>
+struct hb_vector_inline_storage_t<Type, 0>
+{
+  Type *inline_array () { return nullptr; }
+};
+
 template <typename Type,
-	  bool sorted=false>
-struct hb_vector_t
+	  bool sorted=false,
+	  unsigned int inline_size=0>
+struct hb_vector_t : hb_vector_inline_storage_t<Type, inline_size>
 {
   typedef Type item_t;
   static constexpr unsigned item_size = hb_static_size (Type);
@@ -64,25 +81,23 @@ struct hb_vector_t
     if (unlikely (in_error ())) return;
     copy_vector (o);
   }
-  hb_vector_t (hb_vector_t &&o)
+  hb_vector_t (hb_vector_t &&o) : hb_vector_t ()
   {
-    allocated = o.allocated;
-    length = o.length;
-    arrayZ = o.arrayZ;
-    o.init ();
+    move_vector (o);
   }
   ~hb_vector_t () { fini (); }
 
   public:
-  int allocated = 0; /* == -1 means allocation failed. */
+  int allocated = inline_size; /* == -1 means allocation failed. */
   unsigned int length = 0;
   public:
-  Type *arrayZ = nullptr;
+  Type *arrayZ = this->inline_array ();
 
   void init ()
   {
-    allocated = length = 0;
-    arrayZ = nullptr;
+    allocated = inline_size;
+    length = 0;
+    arrayZ = this->inline_array ();
   }
   void init0 ()
   {
@@ -91,10 +106,14 @@ struct hb_vector_t
   void fini ()
   {
     shrink_vector (0);
-    hb_free (arrayZ);
+    if (!is_inline ())
+      hb_free (arrayZ);
     init ();
   }
 
+  bool is_inline () const
+  { return inline_size && arrayZ == const_cast<hb_vector_t *> (this)->inline_array (); }
+
   void reset ()
   {
     if (unlikely (in_error ()))
@@ -108,9 +127,19 @@ struct hb_vector_t
 
   friend void swap (hb_vector_t& a, hb_vector_t& b)
   {
-    hb_swap (a.allocated, b.allocated);
-    hb_swap (a.length, b.length);
-    hb_swap (a.arrayZ, b.arrayZ);
+    if (!a.is_inline () && !b.is_inline ())
+    {
+      hb_swap (a.allocated, b.allocated);
+      hb_swap (a.length, b.length);
+      hb_swap (a.arrayZ, b.arrayZ);
+      return;
+    }
+
+    /* Inline items cannot change hands; move them instead. */
+    hb_vector_t t;
+    t.move_vector (a);
+    a.move_vector (b);
+    b.move_vector (t);
   }
 
   hb_vector_t& operator = (const hb_vector_t &o)
@@ -233,10 +262,19 @@ struct hb_vector_t
   Type *
   realloc_vector (unsigned new_allocated)
   {
+    if (is_inline ())
+    {
+      if (new_allocated <= inline_size)
+	return arrayZ;
+      Type *new_array = (Type *) hb_malloc (new_allocated * sizeof (Type));
+      if (likely (new_array))
+	hb_memcpy ((void *) new_array, (const void *) arrayZ, length * sizeof (Type));
+      return new_array;
+    }
     if (!new_allocated)
     {
       hb_free (arrayZ);
-      return nullptr;
+      return this->inline_array ();
     }
     return (Type *) hb_realloc (arrayZ, new_allocated * sizeof (Type));
   }
@@ -245,10 +283,12 @@ struct hb_vector_t
   Type *
   realloc_vector (unsigned new_allocated)
   {
+    if (is_inline () && new_allocated <= inline_size)
+      return arrayZ;
     if (!new_allocated)
     {
       hb_free (arrayZ);
-      return nullptr;
+      return this->inline_array ();
     }
     Type *new_array = (Type *) hb_malloc (new_allocated * sizeof (Type));
     if (likely (new_array))
@@ -259,7 +299,8 @@ struct hb_vector_t
 	new_array[i] = std::move (arrayZ[i]);
 	arrayZ[i].~Type ();
       }
-      hb_free (arrayZ);
+      if (!is_inline ())
+	hb_free (arrayZ);
     }
     return new_array;
   }
@@ -327,6 +368,26 @@ struct hb_vector_t
     }
   }
 
+  /* Takes over the contents of o; *this must be freshly initialized. */
+  void
+  move_vector (hb_vector_t &o)
+  {
+    if (!o.is_inline ())
+    {
+      allocated = o.allocated;
+      length = o.length;
+      arrayZ = o.arrayZ;
+      o.init ();
+      return;
+    }
+
+    /* Our own inline storage is just as large. */
+    for (unsigned i = 0; i < o.length; i++)
+      new (std::addressof (arrayZ[i])) Type (std::move (o.arrayZ[i]));
+    length = o.length;
+    o.fini ();
+  }
+
   void
   shrink_vector (unsigned size)
   {
@@ -397,7 +458,7 @@ struct hb_vector_t
     }
 
     arrayZ = new_array;
-    allocated = new_allocated;
+    allocated = is_inline () ? inline_size : new_allocated;
 
     return true;
   }
@@ -505,4 +566,8 @@ struct hb_vector_t
 template <typename Type>
 using hb_sorted_vector_t = hb_vector_t<Type, true>;
 
+/* Vector holding up to inline_size items without allocating. */
+template <typename Type, unsigned int inline_size>
+using hb_small_vector_t = hb_vector_t<Type, false, inline_size>;
+
 #endif /* HB_VECTOR_HH */
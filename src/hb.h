@@ -28,6 +28,7 @@
 #define HB_H
 #define HB_H_IN
 
+#include "hb-allocator.h"
 #include "hb-blob.h"
 #include "hb-buffer.h"
 #include "hb-common.h"
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2023  The HarfBuzz Authors
+ *
+ *  This is part of HarfBuzz, a text shaping library.
+ *
+ * Permission is hereby granted, without written agreement and without
+ * license or royalty fees, to use, copy, modify, and distribute this
+ * software and its documentation for any purpose, provided that the
+ * above copyright notice and the following two paragraphs appear in
+ * all copies of this software.
+ *
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES
+ * ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN
+ * IF THE COPYRIGHT HOLDER HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+ * DAMAGE.
+ *
+ * THE COPYRIGHT HOLDER SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE COPYRIGHT HOLDER HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ */
+
+#include "hb.hh"
+#include "hb-ot-layout-common.hh"
+
+using OT::Layout::Common::Coverage;
+
+struct coverage_data_t
+{
+  void u16 (unsigned v) { data << (char) (v >> 8) << (char) v; }
+
+  void format1 (hb_array_t<const unsigned> glyphs)
+  {
+    u16 (1);
+    u16 (glyphs.length);
+    for (unsigned g : glyphs) u16 (g);
+  }
+
+  /* Triplets of first, last, start coverage index. */
+  void format2 (hb_array_t<const unsigned> ranges)
+  {
+    u16 (2);
+    u16 (ranges.length / 3);
+    for (unsigned v : ranges) u16 (v);
+  }
+
+  const Coverage &get () const { return *reinterpret_cast<const Coverage *> (data.arrayZ); }
+
+  hb_vector_t<char> data;
+};
+
+static void
+check_accelerator (const Coverage &coverage, bool expect_success)
+{
+  Coverage::accelerator_t accel;
+  assert (accel.init (coverage) == expect_success);
+  assert (accel.is_empty () == !expect_success);
+  if (!expect_success) return;
+
+  for (hb_codepoint_t g = 0; g < 1200; g++)
+    assert (accel.get_coverage (g) == coverage.get_coverage (g));
+  assert (accel.get_coverage ((hb_codepoint_t) -1) == NOT_COVERED);
+  assert (coverage.get_range_count () >= accel.get_range_count ());
+
+  accel.fini ();
+  assert (accel.is_empty ());
+}
+
+int
+main (int argc, char **argv)
+{
+  /* Format 1, sizes around powers of two to exercise partial tree levels. */
+  for (unsigned n : {0u, 1u, 2u, 3u, 7u, 8u, 9u, 31u, 100u, 255u, 256u, 257u})
+  {
+    hb_vector_t<unsigned> glyphs;
+    for (unsigned i = 0; i < n; i++)
+      glyphs.push (3 + i * 3 + (i & 1));
+    /* Some runs of consecutive glyphs. */
+    for (unsigned i = 0; i < n / 4; i++)
+      glyphs[i * 4 + 1] = glyphs[i * 4] + 1;
+
+    coverage_data_t d;
+    d.format1 (glyphs);
+    check_accelerator (d.get (), true);
+  }
+
+  /* Format 2: adjacent ranges, with and without consecutive indices. */
+  {
+    const unsigned ranges[] = {5, 9, 0,   10, 19, 5,   30, 30, 15,
+			       31, 40, 100,   41, 50, 110,   1000, 1100, 120};
+    coverage_data_t d;
+    d.format2 (ranges);
+    check_accelerator (d.get (), true);
+  }
+
+  /* Malformed data is left to the plain binary search. */
+  {
+    const unsigned glyphs[] = {5, 7, 7, 9};
+    coverage_data_t d;
+    d.format1 (glyphs);
+    check_accelerator (d.get (), false);
+  }
+  {
+    const unsigned ranges[] = {5, 9, 0,   9, 19, 5};
+    coverage_data_t d;
+    d.format2 (ranges);
+    check_accelerator (d.get (), false);
+  }
+  {
+    const unsigned ranges[] = {5, 9, 0,   30, 20, 5};
+    coverage_data_t d;
+    d.format2 (ranges);
+    check_accelerator (d.get (), false);
+  }
+
+  /* Range counts and false-positive estimates, read from the table. */
+  struct all_t { bool may_have (hb_codepoint_t) const { return true; } } all;
+  struct exact_t
+  {
+    const Coverage &c;
+    bool may_have (hb_codepoint_t g) const { return c.has (g); }
+  };
+  {
+    const unsigned glyphs[] = {5, 6, 7, 100, 200};
+    coverage_data_t d;
+    d.format1 (glyphs);
+    Coverage::accelerator_t accel;
+    assert (accel.init (d.get ()));
+    assert (accel.get_range_count () == 3);
+    assert (d.get ().get_range_count () == 3);
+
+    exact_t exact = {d.get ()};
+    assert (d.get ().false_positive_rate (all) == 1.f);
+    assert (d.get ().false_positive_rate (exact) == 0.f);
+  }
+  {
+    const unsigned ranges[] = {5, 9, 0,   10, 19, 5,   30, 40, 15};
+    coverage_data_t d;
+    d.format2 (ranges);
+    assert (d.get ().get_range_count () == 3);
+
+    exact_t exact = {d.get ()};
+    assert (d.get ().false_positive_rate (all) == 1.f);
+    assert (d.get ().false_positive_rate (exact) == 0.f);
+  }
+  {
+    const unsigned glyphs[] = {5};
+    coverage_data_t d;
+    d.format1 (glyphs);
+    assert (d.get ().get_range_count () == 1);
+    assert (d.get ().false_positive_rate (all) == 0.f);
+  }
+  {
+    coverage_data_t d;
+    d.format1 (hb_array_t<const unsigned> ());
+    assert (d.get ().get_range_count () == 0);
+    assert (d.get ().false_positive_rate (all) == 0.f);
+  }
+
+  return 0;
+}
@@ -73,9 +73,86 @@ test_extract ()
   assert (queue.is_empty ());
 }
 
+static void
+test_extract_many ()
+{
+  hb_priority_queue_t queue;
+  for (unsigned i = 0; i < 1000; i++)
+    queue.insert ((i * 7919) % 1000, i);
+
+  int64_t last = -1;
+  for (unsigned i = 0; i < 1000; i++)
+  {
+    auto item = queue.pop_minimum ();
+    assert (item.first > last);
+    assert ((item.second * 7919) % 1000 == item.first);
+    last = item.first;
+  }
+
+  assert (queue.is_empty ());
+}
+
+static void
+test_decrease_priority ()
+{
+  hb_indexed_priority_queue_t queue;
+  queue.insert (50, 5);
+  queue.insert (30, 3);
+  queue.insert (40, 4);
+  assert (queue.has (3));
+  assert (!queue.has (2));
+  assert (!queue.has (100));
+
+  queue.decrease_priority (10, 4);
+  assert (queue.get_population () == 3);
+  assert (queue.minimum () == hb_pair (10, 4));
+
+  // Raising the priority is a no-op.
+  queue.decrease_priority (60, 4);
+  assert (queue.minimum () == hb_pair (10, 4));
+
+  // Values not queued yet are inserted.
+  queue.decrease_priority (20, 2);
+  assert (queue.get_population () == 4);
+
+  assert (queue.pop_minimum () == hb_pair (10, 4));
+  assert (!queue.has (4));
+  assert (queue.pop_minimum () == hb_pair (20, 2));
+  assert (queue.pop_minimum () == hb_pair (30, 3));
+
+  queue.decrease_priority (45, 4);
+  assert (queue.pop_minimum () == hb_pair (45, 4));
+  assert (queue.pop_minimum () == hb_pair (50, 5));
+  assert (queue.is_empty ());
+  assert (!queue.in_error ());
+}
+
+static void
+test_decrease_priority_many ()
+{
+  hb_indexed_priority_queue_t queue;
+  for (unsigned i = 0; i < 1000; i++)
+    queue.insert (1000000 + i, i);
+  for (unsigned i = 0; i < 1000; i++)
+    queue.decrease_priority ((i * 7919) % 1000, i);
+  assert (queue.get_population () == 1000);
+
+  for (unsigned i = 0; i < 1000; i++)
+  {
+    auto item = queue.pop_minimum ();
+    assert (item.first == i);
+    assert ((item.second * 7919) % 1000 == i);
+  }
+
+  assert (queue.is_empty ());
+}
+
 int
 main (int argc, char **argv)
 {
   test_insert ();
   test_extract ();
+  test_extract_many ();
+  test_decrease_priority ();
+  test_decrease_priority_many ();
 }
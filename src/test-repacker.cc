@@ -1501,6 +1501,166 @@ static void test_sort_shortest ()
   free (buffer);
 }
 
+static void test_sort_shortest_incremental ()
+{
+  size_t buffer_size = 100;
+  void* buffer = malloc (buffer_size);
+  hb_serialize_context_t c (buffer, buffer_size);
+  populate_serializer_complex_3 (&c);
+
+  graph_t graph (c.object_graph ());
+  graph_t expected (c.object_graph ());
+  graph.sort_shortest_distance ();
+  expected.sort_shortest_distance ();
+
+  // Duplicate "jkl" (shared by "abc" and "ghi") for "ghi".
+  unsigned parent = (unsigned) -1, child = (unsigned) -1;
+  for (unsigned i = 0; i < graph.vertices_.length; i++)
+  {
+    if (strncmp (graph.object (i).head, "ghi", 3) == 0) parent = i;
+    if (strncmp (graph.object (i).head, "jkl", 3) == 0) child = i;
+  }
+  unsigned clone = graph.duplicate (parent, child);
+  assert (clone != (unsigned) -1);
+  assert (expected.duplicate (parent, child) == clone);
+  graph.sort_shortest_distance_incremental ();
+  expected.sort_shortest_distance ();
+  assert (!graph.in_error ());
+  assert (!expected.in_error ());
+
+  assert (graph.vertices_.length == 7);
+  assert (expected.vertices_.length == 7);
+  for (unsigned i = 0; i < graph.vertices_.length; i++)
+  {
+    assert (graph.object (i).head == expected.object (i).head);
+    assert (graph.object (i).real_links.length == expected.object (i).real_links.length);
+    for (unsigned j = 0; j < graph.object (i).real_links.length; j++)
+      assert (graph.object (i).real_links[j].objidx == expected.object (i).real_links[j].objidx);
+  }
+
+  free (buffer);
+}
+
+static unsigned
+next_random (unsigned* state)
+{
+  *state = *state * 1103515245u + 12345u;
+  return *state >> 16;
+}
+
+static void
+populate_serializer_random_dag (hb_serialize_context_t* c,
+                                unsigned num_nodes,
+                                unsigned* state)
+{
+  c->start_serialize<char> ();
+
+  hb_vector_t<unsigned> ids;
+  hb_vector_t<bool> has_parent;
+  for (unsigned i = 0; i < num_nodes; i++)
+  {
+    start_object ("abcdefgh", 1 + next_random (state) % 8, c);
+    unsigned num_links = i ? next_random (state) % 4 : 0;
+    for (unsigned j = 0; j < num_links; j++)
+    {
+      unsigned child = next_random (state) % i;
+      add_offset (ids[child], c);
+      has_parent[child] = true;
+    }
+    ids.push (c->pop_pack (false));
+    has_parent.push (false);
+  }
+
+  start_object ("root", 4, c);
+  for (unsigned i = 0; i < num_nodes; i++)
+    if (!has_parent[i] || !(next_random (state) % 4))
+      add_offset (ids[i], c);
+  c->pop_pack (false);
+
+  c->end_serialize ();
+}
+
+static void
+assert_same_order (graph_t& graph, graph_t& expected)
+{
+  assert (!graph.in_error ());
+  assert (!expected.in_error ());
+  assert (graph.vertices_.length == expected.vertices_.length);
+  for (unsigned i = 0; i < graph.vertices_.length; i++)
+  {
+    const auto& obj = graph.object (i);
+    const auto& expected_obj = expected.object (i);
+    assert (obj.head == expected_obj.head);
+    assert (obj.tail == expected_obj.tail);
+    assert (obj.real_links.length == expected_obj.real_links.length);
+    for (unsigned j = 0; j < obj.real_links.length; j++)
+    {
+      assert (obj.real_links[j].objidx == expected_obj.real_links[j].objidx);
+      assert (obj.real_links[j].position == expected_obj.real_links[j].position);
+    }
+  }
+}
+
+static void test_sort_shortest_incremental_random ()
+{
+  size_t buffer_size = 4096;
+  void* buffer = malloc (buffer_size);
+  unsigned state = 1;
+
+  for (unsigned round = 0; round < 200; round++)
+  {
+    hb_serialize_context_t c (buffer, buffer_size);
+    populate_serializer_random_dag (&c, 2 + next_random (&state) % 40, &state);
+    assert (!c.in_error ());
+
+    graph_t graph (c.object_graph ());
+    graph_t expected (c.object_graph ());
+    graph.sort_shortest_distance ();
+    expected.sort_shortest_distance ();
+    assert_same_order (graph, expected);
+
+    for (unsigned step = 0; step < 20; step++)
+    {
+      // Apply the same random change to both graphs, then sort one
+      // incrementally and the other from scratch.
+      unsigned index = next_random (&state) % (graph.vertices_.length - 1);
+      switch (next_random (&state) % 4)
+      {
+      case 0:
+      case 1:
+      {
+        // Duplicate one of the children of a node.
+        unsigned parent = index + 1;
+        const auto& links = graph.object (parent).real_links;
+        if (!links) break;
+        unsigned child = links[next_random (&state) % links.length].objidx;
+        unsigned clone = graph.duplicate (parent, child);
+        assert (expected.duplicate (parent, child) == clone);
+        break;
+      }
+      case 2:
+        graph.raise_childrens_priority (index);
+        expected.raise_childrens_priority (index);
+        break;
+      case 3:
+      {
+        hb_set_t indices;
+        indices.add (index);
+        graph.move_to_new_space (indices);
+        expected.move_to_new_space (indices);
+        break;
+      }
+      }
+
+      graph.sort_shortest_distance_incremental ();
+      expected.sort_shortest_distance ();
+      assert_same_order (graph, expected);
+    }
+  }
+
+  free (buffer);
+}
+
 static void test_duplicate_leaf ()
 {
   size_t buffer_size = 100;
@@ -2102,6 +2262,8 @@ main (int argc, char **argv)
 {
   test_serialize ();
   test_sort_shortest ();
+  test_sort_shortest_incremental ();
+  test_sort_shortest_incremental_random ();
   test_will_overflow_1 ();
   test_will_overflow_2 ();
   test_will_overflow_3 ();
@@ -29,6 +29,41 @@
 
 using OT::Layout::Common::Coverage;
 
+/* Serializes a root object with offsets to a number of small objects,
+ * reverting some of them midway. */
+static hb_bytes_t
+serialize_objects (char *buf, unsigned size, bool segmented)
+{
+  hb_serialize_context_t s (buf, size);
+  s.segmented = segmented;
+
+  s.start_serialize<void> ();
+  auto *offsets = s.allocate_size<OT::Offset16> (16 * OT::Offset16::static_size);
+  hb_serialize_context_t::snapshot_t snap;
+  bool reverted = false;
+  for (unsigned i = 0; i < 16; i++)
+  {
+    if (i == 8)
+      snap = s.snapshot ();
+    if (i == 12 && !reverted)
+    {
+      s.revert (snap);
+      reverted = true;
+      i = 8;
+    }
+
+    s.push ();
+    char *p = s.allocate_size<char> (8);
+    if (!p) return hb_bytes_t ();
+    memset (p, (reverted ? 'A' : 'a') + i, 8);
+    s.add_link (offsets[i], s.pop_pack ());
+  }
+
+  s.end_serialize ();
+  if (s.in_error ()) return hb_bytes_t ();
+  return s.copy_bytes ();
+}
+
 int
 main (int argc, char **argv)
 {
@@ -48,5 +83,14 @@ main (int argc, char **argv)
   assert (bytes.length == 10);
   bytes.fini ();
 
+  /* Packed objects do not fit in a small buffer, unless segmented. */
+  hb_bytes_t expected = serialize_objects (buf, sizeof (buf), false);
+  assert (expected.length == 16 * 2 + 16 * 8);
+  assert (!serialize_objects (buf, 64, false));
+  hb_bytes_t segmented = serialize_objects (buf, 64, true);
+  assert (segmented == expected);
+  expected.fini ();
+  segmented.fini ();
+
   return 0;
 }
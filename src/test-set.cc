@@ -25,6 +25,48 @@
 #include "hb.hh"
 #include "hb-set.hh"
 
+/* Checks next_range () and previous_range () against runs found with
+ * has ().  All values of s below limit are checked; from limit on, s
+ * must contain either everything (if inverted) or nothing. */
+static void
+check_ranges (const hb_set_t &s, hb_codepoint_t limit)
+{
+  hb_vector_t<hb_pair_t<hb_codepoint_t, hb_codepoint_t>> runs;
+  for (hb_codepoint_t u = 0; u < limit; u++)
+  {
+    if (!s.has (u)) continue;
+    if (runs && runs.tail ().second + 1 == u)
+      runs.tail ().second = u;
+    else
+      runs.push (hb_pair (u, u));
+  }
+  if (s.is_inverted ())
+  {
+    if (runs && runs.tail ().second + 1 == limit)
+      runs.tail ().second = HB_SET_VALUE_INVALID - 1;
+    else
+      runs.push (hb_pair (limit, HB_SET_VALUE_INVALID - 1));
+  }
+
+  hb_codepoint_t first = HB_SET_VALUE_INVALID, last = HB_SET_VALUE_INVALID;
+  for (const auto &run : runs)
+  {
+    assert (s.next_range (&first, &last));
+    assert (first == run.first);
+    assert (last == run.second);
+  }
+  assert (!s.next_range (&first, &last));
+
+  first = last = HB_SET_VALUE_INVALID;
+  for (unsigned i = runs.length; i; i--)
+  {
+    assert (s.previous_range (&first, &last));
+    assert (first == runs[i - 1].first);
+    assert (last == runs[i - 1].second);
+  }
+  assert (!s.previous_range (&first, &last));
+}
+
 int
 main (int argc, char **argv)
 {
@@ -161,5 +203,102 @@ main (int argc, char **argv)
     assert(s.has(2));
   }
 
+  /* Test hb_bit_page_t::next_unset () and previous_unset (). */
+  {
+    const unsigned PAGE_BITS = hb_bit_page_t::PAGE_BITS;
+    hb_bit_page_t page;
+
+    page.init0 ();
+    assert (page.next_unset (0) == 0);
+    assert (page.next_unset (PAGE_BITS - 1) == PAGE_BITS - 1);
+    assert (page.previous_unset (0) == 0);
+    assert (page.previous_unset (PAGE_BITS - 1) == (int) PAGE_BITS - 1);
+
+    page.init1 ();
+    for (unsigned start : {0u, 1u, 63u, 64u, 65u, PAGE_BITS - 1})
+    {
+      assert (page.next_unset (start) == PAGE_BITS);
+      assert (page.previous_unset (start) == -1);
+    }
+
+    for (unsigned hole : {0u, 1u, 63u, 64u, 127u, 128u, PAGE_BITS - 1})
+    {
+      page.init1 ();
+      page.del (hole);
+      assert (page.next_unset (0) == hole);
+      assert (page.next_unset (hole) == hole);
+      assert (page.previous_unset (PAGE_BITS - 1) == (int) hole);
+      assert (page.previous_unset (hole) == (int) hole);
+      if (hole + 1 < PAGE_BITS)
+      {
+	assert (page.next_unset (hole + 1) == PAGE_BITS);
+	assert (page.previous_unset (hole + 1) == (int) hole);
+      }
+      if (hole)
+      {
+	assert (page.previous_unset (hole - 1) == -1);
+	assert (page.next_unset (hole - 1) == hole);
+      }
+    }
+  }
+
+  /* Test range iteration across page boundaries, over full pages, and
+   * over allocated but empty pages, in plain and inverted sets. */
+  {
+    const hb_codepoint_t P = hb_bit_page_t::PAGE_BITS;
+    const hb_codepoint_t limit = 8 * P;
+    hb_vector_t<hb_set_t> sets;
+
+    /* Contiguous full pages make one run. */
+    sets.push ()->add_range (0, 3 * P - 1);
+    /* Runs ending and starting exactly at page boundaries. */
+    {
+      hb_set_t s;
+      s.add_range (P - 64, P - 1);
+      s.add_range (P + 1, 2 * P - 1);
+      s.add_range (2 * P, 2 * P + 63);
+      s.add_range (4 * P - 1, 4 * P);
+      sets.push (s);
+    }
+    /* A run crossing several pages, and a single value right after a
+     * gap of one. */
+    {
+      hb_set_t s;
+      s.add_range (P / 2, 3 * P + P / 2);
+      s.add (3 * P + P / 2 + 2);
+      sets.push (s);
+    }
+    /* Full pages separated by a missing page, and by an allocated page
+     * that is empty. */
+    {
+      hb_set_t s;
+      s.add_range (0, P - 1);
+      s.add_range (2 * P, 3 * P - 1);
+      s.add (3 * P + 5);
+      s.del (3 * P + 5);
+      s.add_range (4 * P, 5 * P - 1);
+      sets.push (s);
+    }
+    /* Full pages with a single hole at a word or page edge. */
+    {
+      hb_set_t s;
+      s.add_range (0, 6 * P - 1);
+      s.del (P - 1);
+      s.del (2 * P);
+      s.del (3 * P + 63);
+      s.del (3 * P + 64);
+      sets.push (s);
+    }
+    /* Empty set. */
+    sets.push (hb_set_t ());
+
+    for (hb_set_t &s : sets)
+    {
+      check_ranges (s, limit);
+      s.invert ();
+      check_ranges (s, limit);
+    }
+  }
+
   return 0;
 }
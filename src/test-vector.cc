@@ -182,5 +182,55 @@ main (int argc, char **argv)
     v.push (m);
   }
 
+  /* Test inline storage. */
+  {
+    hb_small_vector_t<int, 4> v1;
+    assert (v1.is_inline ());
+    v1 << 1 << 2 << 3;
+    assert (v1.is_inline ());
+    assert (v1.allocated == 4);
+
+    hb_small_vector_t<int, 4> v2 {v1};
+    assert (v2.is_inline ());
+    assert (v2.length == 3 && v2[2] == 3);
+
+    v1 << 4 << 5;
+    assert (!v1.is_inline ());
+    assert (v1.length == 5 && v1[0] == 1 && v1[4] == 5);
+
+    hb_swap (v1, v2);
+    assert (v1.is_inline () && v1.length == 3);
+    assert (!v2.is_inline () && v2.length == 5 && v2[4] == 5);
+
+    hb_small_vector_t<int, 4> v3 (std::move (v1));
+    assert (v1.length == 0 && v1.is_inline ());
+    assert (v3.is_inline () && v3.length == 3 && v3[1] == 2);
+
+    v3 = std::move (v2);
+    assert (v3.length == 5 && v3[4] == 5);
+    assert (v2.length == 3 && v2[0] == 1);
+
+    v3.shrink (0);
+    assert (v3.is_inline ());
+    v3.fini ();
+    assert (v3.is_inline () && !v3.length);
+  }
+
+  {
+    hb_small_vector_t<std::string, 2> v1;
+    v1.push ("a");
+    v1.push ("b");
+    hb_small_vector_t<std::string, 2> v2;
+    v2.push ("c");
+    hb_swap (v1, v2);
+    assert (v1.length == 1 && v1[0] == "c");
+    assert (v2.length == 2 && v2[1] == "b");
+    v2.push ("d");
+    assert (!v2.is_inline ());
+    assert (v2[0] == "a" && v2[2] == "d");
+    v2.remove_ordered (0);
+    assert (v2.length == 2 && v2[0] == "b");
+  }
+
   return 0;
 }
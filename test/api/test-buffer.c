@@ -412,6 +412,47 @@ test_buffer_utf8_conversion (void)
 }
 
 
+/* Long enough to exercise the word-at-a-time ASCII scan and the chunked
+ * decoding in hb_buffer_add_utf8(), including a sequence that straddles
+ * the end of the item. */
+static void
+test_buffer_utf8_long (void)
+{
+  static const char pattern[] = "abcdefg\303\207";
+  const unsigned int pattern_len = sizeof (pattern) - 1;
+  const unsigned int repeats = 1000;
+  char *text;
+  hb_buffer_t *b;
+  hb_glyph_info_t *glyphs;
+  unsigned int i, len;
+
+  text = g_malloc (pattern_len * repeats);
+  for (i = 0; i < repeats; i++)
+    memcpy (text + i * pattern_len, pattern, pattern_len);
+
+  b = hb_buffer_create ();
+  hb_buffer_set_replacement_codepoint (b, (hb_codepoint_t) -1);
+
+  hb_buffer_add_utf8 (b, text, pattern_len * repeats, 0, pattern_len * repeats - 1);
+
+  glyphs = hb_buffer_get_glyph_infos (b, &len);
+  g_assert_cmpint (len, ==, 8 * repeats);
+  for (i = 0; i < len; i++)
+  {
+    unsigned int k = i % 8;
+    g_assert_cmpuint (glyphs[i].cluster, ==, (i / 8) * pattern_len + k);
+    if (k < 7)
+      g_assert_cmphex (glyphs[i].codepoint, ==, 'a' + k);
+    else if (i + 1 < len)
+      g_assert_cmphex (glyphs[i].codepoint, ==, 0xC7);
+    else
+      g_assert_cmphex (glyphs[i].codepoint, ==, (hb_codepoint_t) -1);
+  }
+
+  hb_buffer_destroy (b);
+  g_free (text);
+}
+
 
 /* Following test table is adapted from glib/glib/tests/utf8-validate.c
  * with relicensing permission from Matthias Clasen. */
@@ -924,6 +965,84 @@ test_buffer_serialize_deserialize (void)
 
 }
 
+typedef struct {
+  unsigned int allocs;
+  unsigned int frees;
+  hb_bool_t destroyed;
+} allocator_counts_t;
+
+static void *
+counting_alloc (void *ptr, unsigned int old_size, unsigned int new_size, void *user_data)
+{
+  allocator_counts_t *counts = (allocator_counts_t *) user_data;
+
+  g_assert (ptr || !old_size);
+
+  if (!new_size)
+  {
+    counts->frees++;
+    free (ptr);
+    return NULL;
+  }
+
+  if (!ptr)
+    counts->allocs++;
+  return realloc (ptr, new_size);
+}
+
+static void
+counting_destroy (void *user_data)
+{
+  ((allocator_counts_t *) user_data)->destroyed = TRUE;
+}
+
+static void
+test_buffer_allocator (void)
+{
+  allocator_counts_t counts = {0, 0, FALSE};
+  hb_allocator_t *allocator;
+  hb_buffer_t *b, *b2;
+
+  g_assert (hb_allocator_get_empty ());
+  g_assert (hb_allocator_create (NULL, NULL, NULL) == hb_allocator_get_empty ());
+
+  allocator = hb_allocator_create (counting_alloc, &counts, counting_destroy);
+  g_assert (allocator != hb_allocator_get_empty ());
+
+  b = hb_buffer_create ();
+  g_assert (hb_buffer_get_allocator (b) == hb_allocator_get_empty ());
+  hb_buffer_add_utf32 (b, utf32, G_N_ELEMENTS (utf32), 0, -1);
+
+  hb_buffer_set_allocator (b, allocator);
+  g_assert (hb_buffer_get_allocator (b) == allocator);
+  g_assert_cmpint (hb_buffer_get_length (b), ==, 0);
+  g_assert_cmpint (counts.allocs, ==, 0);
+
+  hb_buffer_add_utf32 (b, utf32, G_N_ELEMENTS (utf32), 0, -1);
+  g_assert_cmpint (hb_buffer_get_length (b), ==, G_N_ELEMENTS (utf32));
+  g_assert (hb_buffer_pre_allocate (b, 1000));
+  g_assert_cmpint (counts.allocs, ==, 2); /* info and pos */
+
+  b2 = hb_buffer_create_similar (b);
+  g_assert (hb_buffer_get_allocator (b2) == allocator);
+  hb_buffer_destroy (b2);
+
+  /* The buffers hold references. */
+  hb_allocator_destroy (allocator);
+  g_assert (!counts.destroyed);
+
+  hb_buffer_reset (b);
+  g_assert (hb_buffer_get_allocator (b) == allocator);
+
+  hb_buffer_destroy (b);
+  g_assert_cmpint (counts.frees, ==, counts.allocs);
+  g_assert (counts.destroyed);
+
+  b = hb_buffer_get_empty ();
+  hb_buffer_set_allocator (b, NULL);
+  g_assert (hb_buffer_get_allocator (b) == hb_allocator_get_empty ());
+}
+
 int
 main (int argc, char **argv)
 {
@@ -944,11 +1063,13 @@ main (int argc, char **argv)
   hb_test_add_fixture (fixture, GINT_TO_POINTER (BUFFER_EMPTY), test_buffer_allocation);
 
   hb_test_add (test_buffer_utf8_conversion);
+  hb_test_add (test_buffer_utf8_long);
   hb_test_add (test_buffer_utf8_validity);
   hb_test_add (test_buffer_utf16_conversion);
   hb_test_add (test_buffer_utf32_conversion);
   hb_test_add (test_buffer_empty);
   hb_test_add (test_buffer_serialize_deserialize);
+  hb_test_add (test_buffer_allocator);
 
   return hb_test_run();
 }
@@ -193,6 +193,53 @@ test_subset_plan (void)
   hb_face_destroy (face_ac);
 }
 
+static void
+test_subset_plan_extend (void)
+{
+  hb_face_t *face_abc = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+
+  hb_set_t *codepoints = hb_set_create();
+  hb_set_add (codepoints, 99);
+  hb_subset_input_t* input = hb_subset_test_create_input (codepoints);
+
+  hb_subset_plan_t* plan = hb_subset_plan_create_or_fail (face_abc, input);
+  g_assert (plan);
+  g_assert (hb_map_get (hb_subset_plan_old_to_new_glyph_mapping (plan), 3) == 1);
+
+  hb_set_clear (codepoints);
+  hb_set_add (codepoints, 97);
+  hb_subset_plan_t* extended = hb_subset_plan_extend_or_fail (plan, codepoints, NULL);
+  g_assert (extended);
+  hb_set_destroy (codepoints);
+
+  /* Glyphs of the base plan keep their ids; new ones come after them. */
+  const hb_map_t* mapping = hb_subset_plan_old_to_new_glyph_mapping (extended);
+  g_assert_cmpuint (hb_map_get_population (mapping), ==, 3);
+  g_assert (hb_map_get (mapping, 0) == 0);
+  g_assert (hb_map_get (mapping, 3) == 1);
+  g_assert (hb_map_get (mapping, 1) == 2);
+
+  mapping = hb_subset_plan_unicode_to_old_glyph_mapping (extended);
+  g_assert (hb_map_get (mapping, 0x61) == 1);
+  g_assert (hb_map_get (mapping, 0x63) == 3);
+
+  hb_face_t* subset = hb_subset_plan_execute_or_fail (extended);
+  g_assert (subset);
+  g_assert_cmpuint (hb_face_get_glyph_count (subset), ==, 3);
+
+  hb_font_t *font = hb_font_create (subset);
+  hb_codepoint_t gid;
+  g_assert (hb_font_get_nominal_glyph (font, 0x61, &gid) && gid == 2);
+  g_assert (hb_font_get_nominal_glyph (font, 0x63, &gid) && gid == 1);
+  hb_font_destroy (font);
+
+  hb_face_destroy (subset);
+  hb_subset_plan_destroy (extended);
+  hb_subset_plan_destroy (plan);
+  hb_subset_input_destroy (input);
+  hb_face_destroy (face_abc);
+}
+
 static hb_blob_t*
 _ref_table (hb_face_t *face, hb_tag_t tag, void *user_data)
 {
@@ -229,6 +276,481 @@ test_subset_create_for_tables_face (void)
   hb_face_destroy (face_ac);
 }
 
+static void
+_run_tasks_serially (hb_subset_task_func_t func,
+		     void **tasks,
+		     unsigned int num_tasks,
+		     void *user_data)
+{
+  unsigned int i;
+  for (i = 0; i < num_tasks; i++)
+    func (tasks[i]);
+  *(unsigned int *) user_data += num_tasks;
+}
+
+static void
+test_subset_parallel (void)
+{
+  hb_face_t *face_abc = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_face_t *face_ac = hb_test_open_font_file ("fonts/Roboto-Regular.ac.ttf");
+  unsigned int num_tasks = 0;
+  hb_face_t *face_abc_subset;
+
+  hb_set_t *codepoints = hb_set_create();
+  hb_set_add (codepoints, 97);
+  hb_set_add (codepoints, 99);
+  hb_subset_input_t* input = hb_subset_test_create_input (codepoints);
+  hb_set_destroy (codepoints);
+
+  g_assert_cmpuint (hb_subset_input_get_num_threads (input), ==, 1);
+  hb_subset_input_set_num_threads (input, 0);
+  g_assert_cmpuint (hb_subset_input_get_num_threads (input), ==, 1);
+  hb_subset_input_set_num_threads (input, 4);
+  g_assert_cmpuint (hb_subset_input_get_num_threads (input), ==, 4);
+
+  face_abc_subset = hb_subset_or_fail (face_abc, input);
+  g_assert (face_abc_subset);
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('l','o','c', 'a'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('g','l','y','f'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('h','m','t','x'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('c','m','a','p'));
+  hb_face_destroy (face_abc_subset);
+
+  hb_subset_input_set_executor (input, _run_tasks_serially, &num_tasks);
+  face_abc_subset = hb_subset_or_fail (face_abc, input);
+  g_assert (face_abc_subset);
+  g_assert_cmpuint (num_tasks, >, 0);
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('l','o','c', 'a'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('g','l','y','f'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('h','m','t','x'));
+  hb_subset_test_check (face_ac, face_abc_subset, HB_TAG ('c','m','a','p'));
+  hb_face_destroy (face_abc_subset);
+
+  hb_subset_input_destroy (input);
+  hb_face_destroy (face_abc);
+  hb_face_destroy (face_ac);
+}
+
+static void
+test_subset_batch (void)
+{
+  hb_face_t *face_abc = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_face_t *face_ac = hb_test_open_font_file ("fonts/Roboto-Regular.ac.ttf");
+  hb_face_t *face_b = hb_test_open_font_file ("fonts/Roboto-Regular.b.ttf");
+  hb_subset_input_t *inputs[3];
+  hb_face_t *subsets[3];
+  unsigned int i;
+
+  hb_set_t *codepoints = hb_set_create();
+  hb_set_add (codepoints, 97);
+  hb_set_add (codepoints, 99);
+  inputs[0] = hb_subset_test_create_input (codepoints);
+  inputs[2] = hb_subset_test_create_input (codepoints);
+  hb_set_clear (codepoints);
+  hb_set_add (codepoints, 98);
+  inputs[1] = hb_subset_test_create_input (codepoints);
+  hb_set_destroy (codepoints);
+
+  g_assert (hb_subset_batch (face_abc, 3, inputs, subsets, 2));
+
+  for (i = 0; i < 3; i += 2)
+  {
+    hb_subset_test_check (face_ac, subsets[i], HB_TAG ('l','o','c', 'a'));
+    hb_subset_test_check (face_ac, subsets[i], HB_TAG ('g','l','y','f'));
+    hb_subset_test_check (face_ac, subsets[i], HB_TAG ('c','m','a','p'));
+  }
+  hb_subset_test_check (face_b, subsets[1], HB_TAG ('O','S','/','2'));
+
+  for (i = 0; i < 3; i++)
+  {
+    hb_face_destroy (subsets[i]);
+    hb_subset_input_destroy (inputs[i]);
+  }
+  hb_face_destroy (face_abc);
+  hb_face_destroy (face_ac);
+  hb_face_destroy (face_b);
+}
+
+/* Returns a copy of serialized preprocessing data with its ranges
+ * replaced by the given (start, end, glyph) triples. */
+static hb_blob_t *
+replace_preprocess_ranges (hb_blob_t *data, const uint32_t *ranges, unsigned count)
+{
+  unsigned header_size = 24, size = header_size + 4 + count * 12;
+  const char *orig = hb_blob_get_data (data, NULL);
+  uint8_t *buf = (uint8_t *) calloc (size, 1);
+  unsigned i;
+
+  memcpy (buf, orig, header_size);
+  for (i = 0; i < 1 + count * 3; i++)
+  {
+    uint32_t v = i ? ranges[i - 1] : count;
+    uint8_t *p = buf + header_size + i * 4;
+    p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+  }
+
+  return hb_blob_create ((const char *) buf, size, HB_MEMORY_MODE_WRITABLE, buf, free);
+}
+
+static void
+test_subset_preprocess_attach_bad_ranges (void)
+{
+  hb_face_t *face_abc = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_face_t *preprocessed = hb_subset_preprocess (face_abc);
+  hb_blob_t *data = hb_subset_preprocess_serialize (preprocessed);
+  hb_blob_t *font_data = hb_face_reference_blob (preprocessed);
+  hb_face_t *restored = hb_face_create (font_data, 0);
+  unsigned num_glyphs = hb_face_get_glyph_count (restored);
+  const uint32_t good[] = {97, 98, 1, 99, 99, 3};
+  const uint32_t huge[] = {97, 0xFFFFFFFFu, 1};
+  const uint32_t beyond_unicode[] = {0x10FFFF, 0x110000, 1};
+  const uint32_t bad_glyph[] = {97, 99, num_glyphs - 2};
+  const uint32_t overlapping[] = {97, 98, 1, 98, 99, 2};
+  const uint32_t unsorted[] = {99, 99, 3, 97, 98, 1};
+  hb_blob_t *blob;
+
+  g_assert_cmpuint (hb_blob_get_length (data), >, 0);
+
+#define TEST_RANGES(ranges, expected) \
+  blob = replace_preprocess_ranges (data, ranges, G_N_ELEMENTS (ranges) / 3); \
+  g_assert_cmpint (hb_subset_preprocess_attach (restored, blob), ==, expected); \
+  hb_blob_destroy (blob);
+
+  TEST_RANGES (huge, FALSE);
+  TEST_RANGES (beyond_unicode, FALSE);
+  TEST_RANGES (bad_glyph, FALSE);
+  TEST_RANGES (overlapping, FALSE);
+  TEST_RANGES (unsorted, FALSE);
+  TEST_RANGES (good, TRUE);
+
+#undef TEST_RANGES
+
+  hb_face_destroy (restored);
+  hb_blob_destroy (font_data);
+  hb_blob_destroy (data);
+  hb_face_destroy (preprocessed);
+  hb_face_destroy (face_abc);
+}
+
+static void
+test_subset_preprocess_serialize (void)
+{
+  hb_face_t *face_abc = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_face_t *face_ac = hb_test_open_font_file ("fonts/Roboto-Regular.ac.ttf");
+  hb_face_t *preprocessed = hb_subset_preprocess (face_abc);
+  hb_blob_t *data, *font_data, *garbage;
+  hb_face_t *restored, *subset;
+
+  data = hb_subset_preprocess_serialize (preprocessed);
+  g_assert_cmpuint (hb_blob_get_length (data), >, 0);
+  g_assert_cmpuint (hb_blob_get_length (hb_subset_preprocess_serialize (face_abc)), ==, 0);
+
+  font_data = hb_face_reference_blob (preprocessed);
+  restored = hb_face_create (font_data, 0);
+  hb_blob_destroy (font_data);
+
+  garbage = hb_blob_create ("hbSA garbage", 12, HB_MEMORY_MODE_READONLY, NULL, NULL);
+  g_assert (!hb_subset_preprocess_attach (restored, garbage));
+  hb_blob_destroy (garbage);
+  g_assert (!hb_subset_preprocess_attach (face_ac, data));
+  g_assert (hb_subset_preprocess_attach (restored, data));
+
+  hb_set_t *codepoints = hb_set_create();
+  hb_set_add (codepoints, 97);
+  hb_set_add (codepoints, 99);
+  subset = hb_subset_test_create_subset (restored, hb_subset_test_create_input (codepoints));
+  hb_set_destroy (codepoints);
+
+  hb_subset_test_check (face_ac, subset, HB_TAG ('l','o','c', 'a'));
+  hb_subset_test_check (face_ac, subset, HB_TAG ('g','l','y','f'));
+  hb_subset_test_check (face_ac, subset, HB_TAG ('c','m','a','p'));
+
+  hb_face_destroy (subset);
+  hb_face_destroy (restored);
+  hb_blob_destroy (data);
+  hb_face_destroy (preprocessed);
+  hb_face_destroy (face_abc);
+  hb_face_destroy (face_ac);
+}
+
+static hb_face_t *
+subset_codepoints (hb_face_t *face, hb_codepoint_t first, hb_codepoint_t second)
+{
+  hb_set_t *codepoints = hb_set_create ();
+  hb_face_t *subset;
+  hb_set_add (codepoints, first);
+  if (second != HB_SET_VALUE_INVALID)
+    hb_set_add (codepoints, second);
+  subset = hb_subset_test_create_subset (face, hb_subset_test_create_input (codepoints));
+  hb_set_destroy (codepoints);
+  return subset;
+}
+
+static void
+test_subset_preprocess_closure_reuse (void)
+{
+  hb_face_t *face = hb_test_open_font_file ("fonts/Roboto-Regular.gsub.fil.ttf");
+  hb_face_t *preprocessed = hb_subset_preprocess (face);
+  hb_codepoint_t requests[][2] = {
+    {'f', 'i'},
+    {'f', 'i'}, /* Same closure input, the closure is reused. */
+    {'f', HB_SET_VALUE_INVALID},
+    {'f', 'l'},
+  };
+
+  for (unsigned i = 0; i < sizeof (requests) / sizeof (requests[0]); i++)
+  {
+    hb_face_t *expected = subset_codepoints (face, requests[i][0], requests[i][1]);
+    hb_face_t *subset = subset_codepoints (preprocessed, requests[i][0], requests[i][1]);
+
+    hb_subset_test_check (expected, subset, HB_TAG ('G','S','U','B'));
+    hb_subset_test_check (expected, subset, HB_TAG ('g','l','y','f'));
+    hb_subset_test_check (expected, subset, HB_TAG ('c','m','a','p'));
+
+    hb_face_destroy (subset);
+    hb_face_destroy (expected);
+  }
+
+  hb_face_destroy (preprocessed);
+  hb_face_destroy (face);
+}
+
+static uint32_t
+read_uint32 (const uint8_t *p)
+{
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+/* OpenType table checksum: the sum of the big-endian uint32s of the
+ * data, zero-padded to a multiple of four bytes. */
+static uint32_t
+table_checksum (const uint8_t *data, unsigned length)
+{
+  uint32_t sum = 0;
+  unsigned i;
+  for (i = 0; i + 4 <= length; i += 4)
+    sum += read_uint32 (data + i);
+  if (i < length)
+  {
+    uint8_t tail[4] = {0, 0, 0, 0};
+    memcpy (tail, data + i, length - i);
+    sum += read_uint32 (tail);
+  }
+  return sum;
+}
+
+/* Checks the table directory of a compiled font, and its head
+ * checkSumAdjustment, against checksums computed from its bytes. */
+static void
+check_font_checksums (const uint8_t *data, unsigned length)
+{
+  unsigned num_tables, i;
+
+  g_assert_cmpuint (length, >=, 12);
+  num_tables = (data[4] << 8) | data[5];
+  g_assert_cmpuint (length, >=, 12 + num_tables * 16);
+
+  for (i = 0; i < num_tables; i++)
+  {
+    const uint8_t *record = data + 12 + i * 16;
+    uint32_t checksum = read_uint32 (record + 4);
+    uint32_t offset = read_uint32 (record + 8);
+    uint32_t table_length = read_uint32 (record + 12);
+    uint32_t sum;
+
+    g_assert_cmpuint (offset % 4, ==, 0);
+    g_assert_cmpuint (offset, <=, length);
+    g_assert_cmpuint (table_length, <=, length - offset);
+
+    sum = table_checksum (data + offset, table_length);
+    if (read_uint32 (record) == HB_TAG ('h','e','a','d'))
+    {
+      /* Computed with checkSumAdjustment taken as zero. */
+      g_assert_cmpuint (table_length, >=, 12);
+      sum -= read_uint32 (data + offset + 8);
+    }
+    g_assert_cmpuint (checksum, ==, sum);
+  }
+
+  g_assert_cmpuint (table_checksum (data, length), ==, 0xB1B0AFBAu);
+}
+
+/* Checks a compiled subset of Roboto-Regular.abc.ttf to 'a' and 'c'
+ * against the known-good fonts/Roboto-Regular.ac.ttf: the tables must
+ * match, only their order in the file, and so checkSumAdjustment, may
+ * differ.  The checksums are checked on their own. */
+static void
+check_compiled_ac_subset (const char *data, unsigned length)
+{
+  hb_face_t *expected = hb_test_open_font_file ("fonts/Roboto-Regular.ac.ttf");
+  hb_blob_t *blob;
+  hb_face_t *compiled;
+  hb_tag_t tags[32];
+  unsigned num_tags, i;
+
+  check_font_checksums ((const uint8_t *) data, length);
+
+  blob = hb_blob_create (data, length, HB_MEMORY_MODE_READONLY, NULL, NULL);
+  compiled = hb_face_create (blob, 0);
+  hb_blob_destroy (blob);
+  num_tags = G_N_ELEMENTS (tags);
+  hb_face_get_table_tags (expected, 0, &num_tags, tags);
+  g_assert_cmpuint (num_tags, <, G_N_ELEMENTS (tags));
+  g_assert_cmpuint (hb_face_get_table_tags (compiled, 0, NULL, NULL), ==, num_tags);
+  for (i = 0; i < num_tags; i++)
+  {
+    hb_blob_t *expected_table = hb_face_reference_table (expected, tags[i]);
+    hb_blob_t *table = hb_face_reference_table (compiled, tags[i]);
+    unsigned expected_length, table_length;
+    const char *expected_data = hb_blob_get_data (expected_table, &expected_length);
+    const char *table_data = hb_blob_get_data (table, &table_length);
+
+    g_assert_cmpuint (table_length, ==, expected_length);
+    if (tags[i] == HB_TAG ('h','e','a','d'))
+    {
+      g_assert_cmpuint (table_length, >=, 12);
+      g_assert (!memcmp (table_data, expected_data, 8));
+      g_assert (!memcmp (table_data + 12, expected_data + 12, table_length - 12));
+    }
+    else
+      g_assert (!memcmp (table_data, expected_data, table_length));
+
+    hb_blob_destroy (table);
+    hb_blob_destroy (expected_table);
+  }
+
+  hb_face_destroy (compiled);
+  hb_face_destroy (expected);
+}
+
+typedef struct
+{
+  char *data;
+  unsigned length;
+  unsigned calls_left;
+} write_buffer_t;
+
+static hb_bool_t
+write_to_buffer (hb_face_t *face HB_UNUSED,
+		 const char *data,
+		 unsigned int length,
+		 void *user_data)
+{
+  write_buffer_t *buffer = (write_buffer_t *) user_data;
+  if (!buffer->calls_left--)
+    return FALSE;
+  buffer->data = (char *) realloc (buffer->data, buffer->length + length);
+  memcpy (buffer->data + buffer->length, data, length);
+  buffer->length += length;
+  return TRUE;
+}
+
+static void
+test_subset_face_builder_write (void)
+{
+  hb_face_t *face = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_set_t *codepoints = hb_set_create ();
+  hb_face_t *subset;
+  write_buffer_t buffer = {NULL, 0, (unsigned) -1};
+
+  hb_set_add (codepoints, 'a');
+  hb_set_add (codepoints, 'c');
+  subset = hb_subset_test_create_subset (face, hb_subset_test_create_input (codepoints));
+  hb_set_destroy (codepoints);
+
+  g_assert (hb_face_builder_write (subset, write_to_buffer, &buffer));
+  check_compiled_ac_subset (buffer.data, buffer.length);
+  free (buffer.data);
+
+  buffer.data = NULL;
+  buffer.length = 0;
+  buffer.calls_left = 2;
+  g_assert (!hb_face_builder_write (subset, write_to_buffer, &buffer));
+  free (buffer.data);
+
+  g_assert (!hb_face_builder_write (face, write_to_buffer, &buffer));
+
+  hb_face_destroy (subset);
+  hb_face_destroy (face);
+}
+
+static void
+test_subset_face_builder_changed_table (void)
+{
+  hb_face_t *builder = hb_face_builder_create ();
+  char *head = (char *) calloc (54, 1);
+  char *table = (char *) calloc (7, 1);
+  hb_blob_t *head_blob = hb_blob_create (head, 54, HB_MEMORY_MODE_WRITABLE, head, free);
+  hb_blob_t *table_blob = hb_blob_create (table, 7, HB_MEMORY_MODE_WRITABLE, table, free);
+  write_buffer_t buffer = {NULL, 0, (unsigned) -1};
+
+  g_assert (hb_face_builder_add_table (builder, HB_TAG ('h','e','a','d'), head_blob));
+  g_assert (hb_face_builder_add_table (builder, HB_TAG ('t','e','s','t'), table_blob));
+
+  /* Writable tables may still change after being added; the directory
+   * must be made from what they hold when the font is compiled. */
+  head[0] = 1;
+  table[0] = 2;
+  table[6] = 3;
+
+  g_assert (hb_face_builder_write (builder, write_to_buffer, &buffer));
+  check_font_checksums ((const uint8_t *) buffer.data, buffer.length);
+  free (buffer.data);
+
+  hb_blob_destroy (table_blob);
+  hb_blob_destroy (head_blob);
+  hb_face_destroy (builder);
+}
+
+static void
+test_subset_face_builder_reference_blobs (void)
+{
+  hb_face_t *face = hb_test_open_font_file ("fonts/Roboto-Regular.abc.ttf");
+  hb_set_t *codepoints = hb_set_create ();
+  hb_face_t *subset;
+  hb_blob_t *blobs[4];
+  char *data = NULL;
+  unsigned length = 0, total, count, offset, i;
+
+  hb_set_add (codepoints, 'a');
+  hb_set_add (codepoints, 'c');
+  subset = hb_subset_test_create_subset (face, hb_subset_test_create_input (codepoints));
+  hb_set_destroy (codepoints);
+
+  total = hb_face_builder_reference_blobs (subset, 0, NULL, NULL);
+  g_assert_cmpuint (total, >, 1);
+
+  for (offset = 0; offset < total; offset += count)
+  {
+    count = G_N_ELEMENTS (blobs);
+    g_assert_cmpuint (hb_face_builder_reference_blobs (subset, offset, &count, blobs), ==, total);
+    g_assert_cmpuint (count, >, 0);
+    for (i = 0; i < count; i++)
+    {
+      unsigned piece_length;
+      const char *piece = hb_blob_get_data (blobs[i], &piece_length);
+      data = (char *) realloc (data, length + piece_length);
+      memcpy (data + length, piece, piece_length);
+      length += piece_length;
+      hb_blob_destroy (blobs[i]);
+    }
+  }
+
+  count = G_N_ELEMENTS (blobs);
+  g_assert_cmpuint (hb_face_builder_reference_blobs (subset, total, &count, blobs), ==, total);
+  g_assert_cmpuint (count, ==, 0);
+
+  check_compiled_ac_subset (data, length);
+  free (data);
+
+  count = G_N_ELEMENTS (blobs);
+  g_assert_cmpuint (hb_face_builder_reference_blobs (face, 0, &count, blobs), ==, 0);
+  g_assert_cmpuint (count, ==, 0);
+
+  hb_face_destroy (subset);
+  hb_face_destroy (face);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -240,7 +762,16 @@ main (int argc, char **argv)
   hb_test_add (test_subset_set_flags);
   hb_test_add (test_subset_sets);
   hb_test_add (test_subset_plan);
+  hb_test_add (test_subset_plan_extend);
   hb_test_add (test_subset_create_for_tables_face);
+  hb_test_add (test_subset_parallel);
+  hb_test_add (test_subset_batch);
+  hb_test_add (test_subset_preprocess_serialize);
+  hb_test_add (test_subset_preprocess_attach_bad_ranges);
+  hb_test_add (test_subset_preprocess_closure_reuse);
+  hb_test_add (test_subset_face_builder_write);
+  hb_test_add (test_subset_face_builder_changed_table);
+  hb_test_add (test_subset_face_builder_reference_blobs);
 
   return hb_test_run();
 }
@@ -847,6 +847,245 @@ test_unicode_subclassing_deep (data_fixture_t *f, gconstpointer user_data HB_UNU
   g_assert (f->data[0].freed && f->data[1].freed);
 }
 
+static void
+test_unicode_subclassing_batch (data_fixture_t *f, gconstpointer user_data HB_UNUSED)
+{
+  hb_unicode_funcs_t *uf, *aa;
+  const hb_codepoint_t text[] = {'a', 'b'};
+  hb_script_t scripts[2];
+
+  uf = hb_unicode_funcs_get_default ();
+  aa = hb_unicode_funcs_create (uf);
+
+  /* The batch callback must agree with an overridden simple callback. */
+  hb_unicode_funcs_set_script_func (aa, a_is_for_arabic_get_script,
+				    &f->data[1], free_up);
+
+  hb_unicode_scripts (aa, 2, text, sizeof (text[0]), scripts, sizeof (scripts[0]));
+  g_assert_cmphex (scripts[0], ==, HB_SCRIPT_ARABIC);
+  g_assert_cmphex (scripts[1], ==, HB_SCRIPT_LATIN);
+
+  /* And go back to the parent's with it. */
+  hb_unicode_funcs_set_script_func (aa, NULL, NULL, NULL);
+  g_assert (f->data[1].freed);
+
+  hb_unicode_scripts (aa, 2, text, sizeof (text[0]), scripts, sizeof (scripts[0]));
+  g_assert_cmphex (scripts[0], ==, HB_SCRIPT_LATIN);
+  g_assert_cmphex (scripts[1], ==, HB_SCRIPT_LATIN);
+
+  hb_unicode_funcs_destroy (aa);
+}
+
+static hb_unicode_general_category_t
+angle_brackets_get_general_category (hb_unicode_funcs_t *ufuncs,
+				     hb_codepoint_t      codepoint,
+				     void               *user_data HB_UNUSED)
+{
+  if (codepoint == '<')
+    return HB_UNICODE_GENERAL_CATEGORY_OPEN_PUNCTUATION;
+  if (codepoint == '>')
+    return HB_UNICODE_GENERAL_CATEGORY_CLOSE_PUNCTUATION;
+  return hb_unicode_general_category (hb_unicode_funcs_get_parent (ufuncs), codepoint);
+}
+
+static hb_codepoint_t
+no_mirroring_get_mirroring (hb_unicode_funcs_t *ufuncs HB_UNUSED,
+			    hb_codepoint_t      codepoint,
+			    void               *user_data HB_UNUSED)
+{
+  return codepoint;
+}
+
+static void
+assert_script_runs (hb_unicode_funcs_t *uf,
+		    const char         *text,
+		    unsigned int        expected_count,
+		    const unsigned int *expected_offsets,
+		    const hb_script_t  *expected_scripts)
+{
+  hb_unicode_script_run_t runs[8];
+  unsigned int run_count = G_N_ELEMENTS (runs);
+  unsigned int i;
+
+  hb_unicode_script_runs_utf8 (uf, text, -1, 0, &run_count, runs);
+  g_assert_cmpuint (run_count, ==, expected_count);
+  for (i = 0; i < run_count; i++)
+  {
+    g_assert_cmpuint (runs[i].offset, ==, expected_offsets[i]);
+    g_assert_cmphex (runs[i].script, ==, expected_scripts[i]);
+  }
+}
+
+static void
+test_unicode_subclassing_script_runs (data_fixture_t *f, gconstpointer user_data HB_UNUSED)
+{
+  hb_unicode_funcs_t *aa;
+
+  /* Overridden funcs must be asked even for all-ASCII text. */
+  aa = hb_unicode_funcs_create (hb_unicode_funcs_get_default ());
+  hb_unicode_funcs_set_script_func (aa, a_is_for_arabic_get_script,
+				    &f->data[1], free_up);
+  {
+    const unsigned int offsets[] = {0, 1, 2};
+    const hb_script_t scripts[] = {HB_SCRIPT_LATIN, HB_SCRIPT_ARABIC, HB_SCRIPT_LATIN};
+    assert_script_runs (aa, "bab", 3, offsets, scripts);
+  }
+
+  /* "א<b>": with the default funcs '<' and '>' are not brackets, so '>'
+   * stays in the Latin run; made brackets, '>' goes back to Hebrew. */
+  {
+    const char text[] = "\xD7\x90<b>";
+    const unsigned int offsets[] = {0, 3, 4};
+    const hb_script_t scripts[] = {HB_SCRIPT_HEBREW, HB_SCRIPT_LATIN, HB_SCRIPT_HEBREW};
+    assert_script_runs (hb_unicode_funcs_get_default (), text, 2, offsets, scripts);
+    hb_unicode_funcs_set_general_category_func (aa, angle_brackets_get_general_category,
+						NULL, NULL);
+    assert_script_runs (aa, text, 3, offsets, scripts);
+  }
+
+  /* "א(b)": the other way around, '(' stops being a bracket once it
+   * does not mirror. */
+  {
+    const char text[] = "\xD7\x90(b)";
+    const unsigned int offsets[] = {0, 3, 4};
+    const hb_script_t scripts[] = {HB_SCRIPT_HEBREW, HB_SCRIPT_LATIN, HB_SCRIPT_HEBREW};
+    assert_script_runs (hb_unicode_funcs_get_default (), text, 3, offsets, scripts);
+    hb_unicode_funcs_set_mirroring_func (aa, no_mirroring_get_mirroring, NULL, NULL);
+    assert_script_runs (aa, text, 2, offsets, scripts);
+  }
+
+  hb_unicode_funcs_destroy (aa);
+  g_assert (f->data[1].freed);
+}
+
+static void
+test_unicode_properties_batch (gconstpointer user_data)
+{
+  hb_unicode_funcs_t *uf = (hb_unicode_funcs_t *) user_data;
+  struct {
+    hb_codepoint_t unicode;
+    hb_unicode_general_category_t general_category;
+    hb_unicode_combining_class_t combining_class;
+    hb_codepoint_t mirroring;
+    hb_script_t script;
+  } items[256];
+  unsigned int i, block;
+
+  for (block = 0; block < 0x30000; block += G_N_ELEMENTS (items) * 7)
+  {
+    for (i = 0; i < G_N_ELEMENTS (items); i++)
+      items[i].unicode = block + i * 7;
+
+    hb_unicode_general_categories (uf, G_N_ELEMENTS (items),
+				   &items[0].unicode, sizeof (items[0]),
+				   &items[0].general_category, sizeof (items[0]));
+    hb_unicode_combining_classes (uf, G_N_ELEMENTS (items),
+				  &items[0].unicode, sizeof (items[0]),
+				  &items[0].combining_class, sizeof (items[0]));
+    hb_unicode_mirrorings (uf, G_N_ELEMENTS (items),
+			   &items[0].unicode, sizeof (items[0]),
+			   &items[0].mirroring, sizeof (items[0]));
+    hb_unicode_scripts (uf, G_N_ELEMENTS (items),
+			&items[0].unicode, sizeof (items[0]),
+			&items[0].script, sizeof (items[0]));
+
+    for (i = 0; i < G_N_ELEMENTS (items); i++)
+    {
+      hb_codepoint_t u = items[i].unicode;
+      g_assert_cmpint (items[i].general_category, ==, hb_unicode_general_category (uf, u));
+      g_assert_cmpint (items[i].combining_class, ==, hb_unicode_combining_class (uf, u));
+      g_assert_cmphex (items[i].mirroring, ==, hb_unicode_mirroring (uf, u));
+      g_assert_cmphex (items[i].script, ==, hb_unicode_script (uf, u));
+    }
+  }
+}
+
+
+static void
+test_unicode_script_runs (gconstpointer user_data)
+{
+  hb_unicode_funcs_t *uf = (hb_unicode_funcs_t *) user_data;
+  /* "(1) abc [אב] def ג (ד) ok" */
+  const char utf8[] = "(1) abc [\xD7\x90\xD7\x91] def \xD7\x92 (\xD7\x93) ok";
+  const struct {
+    unsigned int offset;
+    unsigned int length;
+    hb_script_t script;
+    hb_direction_t direction;
+  } expected[] = {
+    {0, 9, HB_SCRIPT_LATIN, HB_DIRECTION_LTR},	/* "(1) abc [" */
+    {9, 4, HB_SCRIPT_HEBREW, HB_DIRECTION_RTL},	/* "אב" */
+    {13, 6, HB_SCRIPT_LATIN, HB_DIRECTION_LTR},	/* "] def " */
+    {19, 8, HB_SCRIPT_HEBREW, HB_DIRECTION_RTL},	/* "ג (ד) " */
+    {27, 2, HB_SCRIPT_LATIN, HB_DIRECTION_LTR},	/* "ok" */
+  };
+  hb_unicode_script_run_t runs[8];
+  unsigned int run_count, offset, i;
+
+  run_count = G_N_ELEMENTS (runs);
+  offset = hb_unicode_script_runs_utf8 (uf, utf8, -1, 0, &run_count, runs);
+  g_assert_cmpuint (offset, ==, sizeof (utf8) - 1);
+  g_assert_cmpuint (run_count, ==, G_N_ELEMENTS (expected));
+  for (i = 0; i < run_count; i++)
+  {
+    g_assert_cmpuint (runs[i].offset, ==, expected[i].offset);
+    g_assert_cmpuint (runs[i].length, ==, expected[i].length);
+    g_assert_cmphex (runs[i].script, ==, expected[i].script);
+    g_assert_cmpint (runs[i].direction, ==, expected[i].direction);
+  }
+
+  /* Resume after running out of room.  Bracket pairs are not tracked
+   * across calls, so use text without any. */
+  {
+    /* "ab אב cd ג" */
+    const char text[] = "ab \xD7\x90\xD7\x91 cd \xD7\x92";
+    const unsigned int starts[] = {0, 3, 8, 11, 13};
+
+    offset = 0;
+    for (i = 0; i + 1 < G_N_ELEMENTS (starts); i++)
+    {
+      run_count = 1;
+      offset = hb_unicode_script_runs_utf8 (uf, text, -1, offset, &run_count, runs);
+      g_assert_cmpuint (run_count, ==, 1);
+      g_assert_cmpuint (runs[0].offset, ==, starts[i]);
+      g_assert_cmpuint (runs[0].length, ==, starts[i + 1] - starts[i]);
+      g_assert_cmphex (runs[0].script, ==, i % 2 ? HB_SCRIPT_HEBREW : HB_SCRIPT_LATIN);
+      g_assert_cmpuint (offset, ==, starts[i + 1]);
+    }
+    run_count = 1;
+    g_assert_cmpuint (hb_unicode_script_runs_utf8 (uf, text, -1, offset, &run_count, runs), ==, offset);
+    g_assert_cmpuint (run_count, ==, 0);
+  }
+
+  /* The same text in UTF-16 and UTF-32; offsets are in code units. */
+  {
+    const uint16_t utf16[] = {'a', ' ', 0x05D0, 0xD801, 0xDC00, ' ', '1', 0};
+    const uint32_t utf32[] = {'a', ' ', 0x05D0, 0x10400, ' ', '1', 0};
+
+    run_count = G_N_ELEMENTS (runs);
+    g_assert_cmpuint (hb_unicode_script_runs_utf16 (uf, utf16, -1, 0, &run_count, runs), ==, 7);
+    g_assert_cmpuint (run_count, ==, 3);
+    g_assert_cmpuint (runs[1].offset, ==, 2);
+    g_assert_cmphex (runs[1].script, ==, HB_SCRIPT_HEBREW);
+    g_assert_cmpuint (runs[2].offset, ==, 3);
+    g_assert_cmpuint (runs[2].length, ==, 4);
+    g_assert_cmphex (runs[2].script, ==, HB_SCRIPT_DESERET);
+
+    run_count = G_N_ELEMENTS (runs);
+    g_assert_cmpuint (hb_unicode_script_runs_utf32 (uf, utf32, -1, 0, &run_count, runs), ==, 6);
+    g_assert_cmpuint (run_count, ==, 3);
+    g_assert_cmpuint (runs[2].offset, ==, 3);
+    g_assert_cmpuint (runs[2].length, ==, 3);
+  }
+
+  /* Text without any real script is a single Common run. */
+  run_count = G_N_ELEMENTS (runs);
+  g_assert_cmpuint (hb_unicode_script_runs_utf8 (uf, "12 (3)", -1, 0, &run_count, runs), ==, 6);
+  g_assert_cmpuint (run_count, ==, 1);
+  g_assert_cmphex (runs[0].script, ==, HB_SCRIPT_COMMON);
+  g_assert_cmpint (runs[0].direction, ==, HB_DIRECTION_LTR);
+}
+
 
 static hb_script_t
 script_roundtrip_default (hb_script_t script)
@@ -988,6 +1227,8 @@ main (int argc, char **argv)
 
   hb_test_add_data_flavor (hb_unicode_funcs_get_default (),          "default", test_unicode_properties_strict);
   hb_test_add_data_flavor (hb_unicode_funcs_get_default (),          "default", test_unicode_normalization);
+  hb_test_add_data_flavor (hb_unicode_funcs_get_default (),          "default", test_unicode_properties_batch);
+  hb_test_add_data_flavor (hb_unicode_funcs_get_default (),          "default", test_unicode_script_runs);
   hb_test_add_data_flavor ((gconstpointer) script_roundtrip_default, "default", test_unicode_script_roundtrip);
 #ifdef HAVE_GLIB
   hb_test_add_data_flavor (hb_glib_get_unicode_funcs (),             "glib",    test_unicode_properties_lenient);
@@ -1007,6 +1248,8 @@ main (int argc, char **argv)
   hb_test_add_fixture (data_fixture, NULL, test_unicode_subclassing_nil);
   hb_test_add_fixture (data_fixture, NULL, test_unicode_subclassing_default);
   hb_test_add_fixture (data_fixture, NULL, test_unicode_subclassing_deep);
+  hb_test_add_fixture (data_fixture, NULL, test_unicode_subclassing_batch);
+  hb_test_add_fixture (data_fixture, NULL, test_unicode_subclassing_script_runs);
 
   return hb_test_run ();
 }